@@ -0,0 +1,102 @@
+#pragma once
+
+#include "BoardHash.h"
+#include "Macros.h"
+#include "Move.h"
+
+#include <array>
+#include <atomic>
+
+#include <cstdint>
+
+// Shared table of moves that are currently being searched by some thread, for ABDADA-style
+// parallel search (see Tom Kerrigan, "A simplified ABDADA"). A thread that is about to search a
+// move that another thread is already searching defers it to the end of its move loop, by which
+// time the result is hopefully available from the transposition table.
+//
+// The table is small and lossy: markers may be overwritten by other moves, in which case a move is
+// searched twice, or may be stale, in which case a move is deferred unnecessarily. Neither affects
+// correctness.
+class ActiveMovesTable {
+  public:
+    // Moves are only marked at nodes of at least this depth; below that the bookkeeping costs more
+    // than duplicated work.
+    static constexpr int kMinDepth = 3;
+
+    ActiveMovesTable() = default;
+
+    ActiveMovesTable(const ActiveMovesTable&)            = delete;
+    ActiveMovesTable& operator=(const ActiveMovesTable&) = delete;
+
+    [[nodiscard]] static HashT getMoveHash(HashT boardHash, const Move& move);
+
+    [[nodiscard]] bool isBeingSearched(HashT moveHash) const;
+
+    void startSearching(HashT moveHash);
+
+    void finishSearching(HashT moveHash);
+
+  private:
+    static constexpr std::size_t kNumSets = 1 << 15;
+    static constexpr int kNumWays         = 4;
+
+    using Set = std::array<std::atomic<HashT>, kNumWays>;
+
+    [[nodiscard]] Set& getSet(HashT moveHash);
+    [[nodiscard]] const Set& getSet(HashT moveHash) const;
+
+    std::array<Set, kNumSets> sets_ = {};
+};
+
+FORCE_INLINE inline HashT ActiveMovesTable::getMoveHash(const HashT boardHash, const Move& move) {
+    static constexpr HashT kMoveMultiplier = 0x9E37'79B9'7F4A'7C15ULL;
+
+    const HashT moveBits = (HashT)move.from | ((HashT)move.to << 6) | ((HashT)move.flags << 12);
+
+    // + 1 so that the null move also changes the hash.
+    return boardHash ^ ((moveBits + 1) * kMoveMultiplier);
+}
+
+FORCE_INLINE inline bool ActiveMovesTable::isBeingSearched(const HashT moveHash) const {
+    for (const auto& way : getSet(moveHash)) {
+        if (way.load(std::memory_order_relaxed) == moveHash) {
+            return true;
+        }
+    }
+    return false;
+}
+
+FORCE_INLINE inline void ActiveMovesTable::startSearching(const HashT moveHash) {
+    Set& set = getSet(moveHash);
+
+    for (auto& way : set) {
+        const HashT stored = way.load(std::memory_order_relaxed);
+        if (stored == 0) {
+            way.store(moveHash, std::memory_order_relaxed);
+            return;
+        }
+        if (stored == moveHash) {
+            return;
+        }
+    }
+
+    // All ways are in use; overwrite the last one.
+    set.back().store(moveHash, std::memory_order_relaxed);
+}
+
+FORCE_INLINE inline void ActiveMovesTable::finishSearching(const HashT moveHash) {
+    for (auto& way : getSet(moveHash)) {
+        if (way.load(std::memory_order_relaxed) == moveHash) {
+            way.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+FORCE_INLINE inline ActiveMovesTable::Set& ActiveMovesTable::getSet(const HashT moveHash) {
+    return sets_[moveHash & (kNumSets - 1)];
+}
+
+FORCE_INLINE inline const ActiveMovesTable::Set& ActiveMovesTable::getSet(
+        const HashT moveHash) const {
+    return sets_[moveHash & (kNumSets - 1)];
+}
@@ -6,6 +6,14 @@
 #include <algorithm>
 #include <atomic>
 
+namespace {
+
+// The static eval is usually already available from the transposition table, so by default the
+// eval hash is disabled: it costs memory per thread without a measurable speedup.
+constexpr int kDefaultEvalHashTableSizeInMb = 0;
+
+}  // namespace
+
 class Engine::Impl {
   public:
     Impl();
@@ -32,10 +40,14 @@ class Engine::Impl {
 
     void setTTableSize(int requestedSizeInMb);
 
+    void waitUntilReady();
+
     [[nodiscard]] EvalT evaluate(const GameState& gameState) const;
 
     void initializeSyzygy(std::string_view syzygyDir);
 
+    void setEvalFile(std::string_view evalFile);
+
   private:
     StackOfVectors<Move> moveStack_;
     TimeManager timeManager_;
@@ -49,7 +61,10 @@ class Engine::Impl {
 };
 
 Engine::Impl::Impl()
-    : evaluator_(EvalParams::getDefaultParams(), /*usePawnKingEvalHashTable*/ true),
+    : evaluator_(
+              EvalParams::getDefaultParams(),
+              /*usePawnKingEvalHashTable*/ true,
+              kDefaultEvalHashTableSizeInMb),
       moveSearcher_(timeManager_, evaluator_) {
     moveStack_.reserve(1'000);
 }
@@ -72,6 +87,17 @@ void Engine::Impl::setFrontEnd(IFrontEnd* frontEnd) {
 
     frontEnd_->addOption(FrontEndOption::createString(
             "SyzygyPath", "", [this](const std::string_view v) { initializeSyzygy(v); }));
+
+    // Empty: use the hand-crafted evaluation.
+    frontEnd_->addOption(FrontEndOption::createString(
+            "EvalFile", "", [this](const std::string_view v) { setEvalFile(v); }));
+
+    // Size per search thread.
+    frontEnd_->addOption(FrontEndOption::createInteger(
+            "EvalHash", kDefaultEvalHashTableSizeInMb, 0, 1024, [this](const int sizeInMb) {
+                evaluator_.setEvalHashTableSize(sizeInMb);
+                moveSearcher_.setEvalHashTableSize(sizeInMb);
+            }));
 }
 
 void Engine::Impl::newGame() {
@@ -141,6 +167,7 @@ SearchInfo Engine::Impl::findMove(
     moveSearcher_.prepareForNewSearch(gameState, movesToSearch, tbHit);
 
     GameState copyState(gameState);
+    evaluator_.attachNnueAccumulator(copyState);
 
     std::optional<EvalT> evalGuess = std::nullopt;
     SearchInfo searchInfo;
@@ -153,6 +180,8 @@ SearchInfo Engine::Impl::findMove(
         evalGuess = rootNodeInfo->eval;
     }
 
+    moveSearcher_.startHelperSearches(gameState);
+
     if (frontEnd_) {
         // Preparations are done; we can now safely process an interrupt request.
         // Report to the front end that the search has started.
@@ -199,6 +228,8 @@ SearchInfo Engine::Impl::findMove(
         }
     }
 
+    moveSearcher_.stopHelperSearches();
+
     if (frontEnd_) {
         frontEnd_->reportSearchStatistics(searchInfo.statistics);
     }
@@ -245,6 +276,10 @@ void Engine::Impl::setTTableSize(const int requestedSizeInMb) {
     moveSearcher_.setTTableSize(requestedSizeInMb);
 }
 
+void Engine::Impl::waitUntilReady() {
+    moveSearcher_.waitUntilReady();
+}
+
 EvalT Engine::Impl::evaluate(const GameState& gameState) const {
     return evaluator_.evaluate(gameState);
 }
@@ -277,6 +312,22 @@ void Engine::Impl::initializeSyzygy(std::string_view syzygyDir) {
     moveSearcher_.setSyzygyEnabled(hasSyzygy_);
 }
 
+void Engine::Impl::setEvalFile(std::string_view evalFile) {
+    std::shared_ptr<const NnueNetwork> network;
+    if (!evalFile.empty()) {
+        network = NnueNetwork::loadFromFile(std::string(evalFile));
+    }
+
+    evaluator_.setNnueNetwork(network);
+    moveSearcher_.setNnueNetwork(network);
+
+    if (frontEnd_) {
+        frontEnd_->reportString(
+                network ? "Using NNUE evaluation from " + std::string(evalFile) + "."
+                        : "Using hand-crafted evaluation.");
+    }
+}
+
 // Implementation of interface: forward to implementation
 
 Engine::Engine() : impl_(std::make_unique<Engine::Impl>()) {}
@@ -311,6 +362,10 @@ void Engine::setTTableSize(const int requestedSizeInMb) {
     impl_->setTTableSize(requestedSizeInMb);
 }
 
+void Engine::waitUntilReady() {
+    impl_->waitUntilReady();
+}
+
 EvalT Engine::evaluate(const GameState& gameState) const {
     return impl_->evaluate(gameState);
 }
@@ -33,6 +33,8 @@ class Engine final : public IEngine {
 
     void setTTableSize(int requestedSizeInMb) override;
 
+    void waitUntilReady() override;
+
     [[nodiscard]] EvalT evaluate(const GameState& gameState) const override;
 
   private:
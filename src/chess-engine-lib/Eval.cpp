@@ -1,13 +1,17 @@
 #include "Eval.h"
 
 #include "BitBoard.h"
+#include "DefaultEvalParams.h"
 #include "Intrinsics.h"
 #include "Macros.h"
 #include "Math.h"
+#include "ParallelFor.h"
 #include "PawnMasks.h"
 #include "PieceControl.h"
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <optional>
 #include <type_traits>
 #include <utility>
@@ -25,6 +29,19 @@ static_assert(isPowerOfTwo(kPawnKingHashTableEntries));
 
 constexpr std::size_t kPawnKingHashTableMask = kPawnKingHashTableEntries - 1;
 
+// When evaluating a batch, prefetch the hash table entries of the position this far ahead.
+constexpr std::size_t kBatchPrefetchDistance = 4;
+
+#ifdef EUWE_CONSTEXPR_EVAL_PARAMS
+constexpr bool kUseConstexprEvalParams = true;
+#else
+constexpr bool kUseConstexprEvalParams = false;
+#endif
+
+// The default params as a compile time constant. Evaluating against these instead of the runtime
+// params allows the compiler to constant-fold the weights and skip terms that are zero.
+constexpr Evaluator::EvalCalcParams kDefaultEvalCalcParams(kDefaultEvalParams);
+
 using PstMappingBySide = std::array<PstMapping, kNumSides>;
 
 struct PstMappings {
@@ -80,22 +97,71 @@ constexpr PstMappings kPstMappings = []() {
     return mappings;
 }();
 
-VectorT zeros() {
-    return std::valarray<double>((EvalCalcT)0, kNumEvalParams);
-}
-
+// While evaluating, gradients are unsorted and may contain several entries for the same param.
+// compactGradient brings them into the form described for SparseGradient.
 template <bool CalcJacobians>
-using ParamGradient = std::conditional_t<CalcJacobians, VectorT, std::monostate>;
+using ParamGradient = std::conditional_t<CalcJacobians, SparseGradient, std::monostate>;
 
 template <bool CalcJacobians>
 [[nodiscard]] FORCE_INLINE ParamGradient<CalcJacobians> zeroGradient() {
     if constexpr (CalcJacobians) {
-        return zeros();
+        return {};
     } else {
         return std::monostate{};
     }
 }
 
+FORCE_INLINE void addToGradient(
+        SparseGradient& gradient, const std::size_t paramIdx, const double derivative) {
+    gradient.push_back({.paramIdx = (std::uint32_t)paramIdx, .derivative = derivative});
+}
+
+// gradient += scale * other
+FORCE_INLINE void addScaledGradient(
+        SparseGradient& gradient, const SparseGradient& other, const double scale) {
+    for (const auto& [paramIdx, derivative] : other) {
+        gradient.push_back({.paramIdx = paramIdx, .derivative = scale * derivative});
+    }
+}
+
+FORCE_INLINE void scaleGradient(SparseGradient& gradient, const double scale) {
+    for (auto& entry : gradient) {
+        entry.derivative *= scale;
+    }
+}
+
+// Sort by param index, and merge entries for the same param. Entries that sum to zero are dropped.
+void compactGradient(SparseGradient& gradient) {
+    // Sum the entries into a dense buffer, and gather them back in param order using a bit set of
+    // the params that were touched. This is cheaper than sorting, since there are many more entries
+    // than distinct params. The buffer is all zeros in between calls.
+    constexpr std::size_t kNumWords = (kNumEvalParams + 63) / 64;
+
+    thread_local std::array<double, kNumEvalParams> derivatives{};
+    std::array<std::uint64_t, kNumWords> touchedParams{};
+
+    for (const auto& [paramIdx, derivative] : gradient) {
+        derivatives[paramIdx] += derivative;
+        touchedParams[paramIdx / 64] |= 1ULL << (paramIdx % 64);
+    }
+
+    gradient.clear();
+
+    for (std::size_t wordIdx = 0; wordIdx < kNumWords; ++wordIdx) {
+        std::uint64_t touchedInWord = touchedParams[wordIdx];
+        while (touchedInWord != 0) {
+            const std::size_t paramIdx = wordIdx * 64 + std::countr_zero(touchedInWord);
+            touchedInWord &= touchedInWord - 1;
+
+            if (derivatives[paramIdx] != 0) {
+                gradient.push_back(
+                        {.paramIdx = (std::uint32_t)paramIdx, .derivative = derivatives[paramIdx]});
+            }
+            derivatives[paramIdx] = 0;
+        }
+    }
+}
+
 template <bool CalcJacobians>
 struct TermWithGradient;
 
@@ -138,8 +204,8 @@ FORCE_INLINE void updateTaperedTerm(
     eval.late.value += term.late * weight;
 
     if constexpr (CalcJacobians) {
-        eval.early.grad[params.getParamIndex(term.early)] += weight;
-        eval.late.grad[params.getParamIndex(term.late)] += weight;
+        addToGradient(eval.early.grad, params.getParamIndex(term.early), weight);
+        addToGradient(eval.late.grad, params.getParamIndex(term.late), weight);
     }
 }
 
@@ -153,11 +219,11 @@ FORCE_INLINE void updateTaperedProductTerm(
     eval.late.value += factor1.late * factor2.late;
 
     if constexpr (CalcJacobians) {
-        eval.early.grad[params.getParamIndex(factor1.early)] += factor2.early;
-        eval.late.grad[params.getParamIndex(factor1.late)] += factor2.late;
+        addToGradient(eval.early.grad, params.getParamIndex(factor1.early), factor2.early);
+        addToGradient(eval.late.grad, params.getParamIndex(factor1.late), factor2.late);
 
-        eval.early.grad[params.getParamIndex(factor2.early)] += factor1.early;
-        eval.late.grad[params.getParamIndex(factor2.late)] += factor1.late;
+        addToGradient(eval.early.grad, params.getParamIndex(factor2.early), factor1.early);
+        addToGradient(eval.late.grad, params.getParamIndex(factor2.late), factor1.late);
     }
 }
 
@@ -178,7 +244,10 @@ FORCE_INLINE void updatePiecePositionEvaluation(
         PiecePositionEvaluation<CalcJacobians>& result) {
     result.phaseMaterial.value += params.phaseMaterialValues[pieceIdx];
     if constexpr (CalcJacobians) {
-        result.phaseMaterial.grad[params.getParamIndex(params.phaseMaterialValues[pieceIdx])] += 1;
+        addToGradient(
+                result.phaseMaterial.grad,
+                params.getParamIndex(params.phaseMaterialValues[pieceIdx]),
+                1);
     }
 
     int pstIndex{};
@@ -828,96 +897,55 @@ FORCE_INLINE void modifyForFactor(
         const EvalCalcT& factor,
         TermWithGradient<CalcJacobians>& whiteEval) {
     if constexpr (CalcJacobians) {
-        whiteEval.grad *= factor;
+        const std::size_t factorIdx = params.getParamIndex(factor);
+        MY_ASSERT(std::ranges::none_of(whiteEval.grad, [&](const GradientEntry& entry) {
+            return entry.paramIdx == factorIdx;
+        }));
 
-        auto& dEvalDFactor = whiteEval.grad[params.getParamIndex(factor)];
-        MY_ASSERT(dEvalDFactor == 0);
-        dEvalDFactor = whiteEval.value;
+        scaleGradient(whiteEval.grad, factor);
+        addToGradient(whiteEval.grad, factorIdx, whiteEval.value);
     }
 
     whiteEval.value *= factor;
 }
 
-template <bool CalcJacobians>
-[[nodiscard]] FORCE_INLINE bool correctForOppositeColoredBishops(
-        const GameState& gameState,
-        const Evaluator::EvalCalcParams& params,
-        TermWithGradient<CalcJacobians>& whiteEval) {
-    const BitBoard anyOtherPiece = gameState.getPieceBitBoard(Side::White, Piece::Knight)
-                                 | gameState.getPieceBitBoard(Side::White, Piece::Rook)
-                                 | gameState.getPieceBitBoard(Side::White, Piece::Queen)
-                                 | gameState.getPieceBitBoard(Side::Black, Piece::Knight)
-                                 | gameState.getPieceBitBoard(Side::Black, Piece::Rook)
-                                 | gameState.getPieceBitBoard(Side::Black, Piece::Queen);
-
-    if (anyOtherPiece != BitBoard::Empty) {
-        return false;
-    }
-
-    const BitBoard whiteDarkBishops =
-            gameState.getPieceBitBoard(Side::White, Piece::Bishop) & kDarkSquareBitBoard;
-    const BitBoard whiteLightBishops =
-            gameState.getPieceBitBoard(Side::White, Piece::Bishop) & kLightSquareBitBoard;
-    const BitBoard blackDarkBishops =
-            gameState.getPieceBitBoard(Side::Black, Piece::Bishop) & kDarkSquareBitBoard;
-    const BitBoard blackLightBishops =
-            gameState.getPieceBitBoard(Side::Black, Piece::Bishop) & kLightSquareBitBoard;
-
-    const bool bishopsAreOppositeColor =
-            ((whiteDarkBishops != BitBoard::Empty) ^ (blackDarkBishops != BitBoard::Empty))
-            && ((whiteLightBishops != BitBoard::Empty) ^ (blackLightBishops != BitBoard::Empty));
-
-    if (!bishopsAreOppositeColor) {
-        return false;
+[[nodiscard]] bool hasOppositeColoredBishopsOnly(const MaterialKey& materialKey) {
+    for (const Side side : {Side::White, Side::Black}) {
+        if (!materialKey.hasNone(side, Piece::Knight) || !materialKey.hasNone(side, Piece::Rook)
+            || !materialKey.hasNone(side, Piece::Queen)) {
+            return false;
+        }
     }
 
-    const int whitePawns = popCount(gameState.getPieceBitBoard(Side::White, Piece::Pawn));
-    const int blackPawns = popCount(gameState.getPieceBitBoard(Side::Black, Piece::Pawn));
-
-    const int pawnDelta = std::abs(whitePawns - blackPawns);
-    const int factorIdx = min(pawnDelta, (int)params.oppositeColoredBishopFactor.size() - 1);
+    const bool whiteHasDarkBishop  = materialKey.getBishopCount(Side::White, 0) > 0;
+    const bool whiteHasLightBishop = materialKey.getBishopCount(Side::White, 1) > 0;
+    const bool blackHasDarkBishop  = materialKey.getBishopCount(Side::Black, 0) > 0;
+    const bool blackHasLightBishop = materialKey.getBishopCount(Side::Black, 1) > 0;
 
-    modifyForFactor<CalcJacobians>(
-            params, params.oppositeColoredBishopFactor[factorIdx], whiteEval);
-
-    return true;
+    return (whiteHasDarkBishop ^ blackHasDarkBishop) && (whiteHasLightBishop ^ blackHasLightBishop);
 }
 
-template <bool CalcJacobians>
-void correctForDrawish(
-        const GameState& gameState,
-        const Evaluator::EvalCalcParams& params,
-        TermWithGradient<CalcJacobians>& whiteEval) {
-    if (correctForOppositeColoredBishops<CalcJacobians>(gameState, params, whiteEval)) {
-        return;
+[[nodiscard]] DrawishCorrection getDrawishCorrection(
+        const MaterialKey& materialKey, const Side strongerSide) {
+    if (hasOppositeColoredBishopsOnly(materialKey)) {
+        return DrawishCorrection::OppositeColoredBishops;
     }
 
-    const bool whiteIsStronger = whiteEval.value >= 0;
+    const Side weakerSide = nextSide(strongerSide);
 
-    const int strongerSidePawns =
-            whiteIsStronger ? popCount(gameState.getPieceBitBoard(Side::White, Piece::Pawn))
-                            : popCount(gameState.getPieceBitBoard(Side::Black, Piece::Pawn));
-
-    if (strongerSidePawns > 0) {
-        return;
+    if (!materialKey.hasNone(strongerSide, Piece::Pawn)) {
+        return DrawishCorrection::None;
     }
 
-    int strongSideKnights = popCount(gameState.getPieceBitBoard(Side::White, Piece::Knight));
-    int strongSideBishops = popCount(gameState.getPieceBitBoard(Side::White, Piece::Bishop));
-    int strongSideRooks   = popCount(gameState.getPieceBitBoard(Side::White, Piece::Rook));
-    int strongSideQueens  = popCount(gameState.getPieceBitBoard(Side::White, Piece::Queen));
+    const int strongSideKnights = materialKey.getCount(strongerSide, Piece::Knight);
+    const int strongSideBishops = materialKey.getCount(strongerSide, Piece::Bishop);
+    const int strongSideRooks   = materialKey.getCount(strongerSide, Piece::Rook);
+    const int strongSideQueens  = materialKey.getCount(strongerSide, Piece::Queen);
 
-    int weakSideKnights = popCount(gameState.getPieceBitBoard(Side::Black, Piece::Knight));
-    int weakSideBishops = popCount(gameState.getPieceBitBoard(Side::Black, Piece::Bishop));
-    int weakSideRooks   = popCount(gameState.getPieceBitBoard(Side::Black, Piece::Rook));
-    int weakSideQueens  = popCount(gameState.getPieceBitBoard(Side::Black, Piece::Queen));
-
-    if (!whiteIsStronger) {
-        std::swap(strongSideKnights, weakSideKnights);
-        std::swap(strongSideBishops, weakSideBishops);
-        std::swap(strongSideRooks, weakSideRooks);
-        std::swap(strongSideQueens, weakSideQueens);
-    }
+    const int weakSideKnights = materialKey.getCount(weakerSide, Piece::Knight);
+    const int weakSideBishops = materialKey.getCount(weakerSide, Piece::Bishop);
+    const int weakSideRooks   = materialKey.getCount(weakerSide, Piece::Rook);
+    const int weakSideQueens  = materialKey.getCount(weakerSide, Piece::Queen);
 
     const int strongSideMinorPieces = strongSideKnights + strongSideBishops;
     const int strongSideMajorPieces = strongSideRooks + strongSideQueens;
@@ -927,29 +955,211 @@ void correctForDrawish(
 
     // With only a single minor piece you can't reliably deliver mate.
     if (strongSideMajorPieces == 0 && strongSideMinorPieces == 1) {
-        modifyForFactor<CalcJacobians>(params, params.singleMinorFactor, whiteEval);
-        return;
+        return DrawishCorrection::SingleMinor;
     }
 
     // Only two knights; this is insufficient material once the weaker side has lost their material.
     if (strongSideMajorPieces == 0 && strongSideKnights == 2 && strongSideBishops == 0) {
-        modifyForFactor<CalcJacobians>(params, params.twoKnightsFactor, whiteEval);
-        return;
+        return DrawishCorrection::TwoKnights;
     }
 
     // Rook vs a minor piece is drawish.
     if (strongSideRooks == 1 && strongSideQueens == 0 && strongSideMinorPieces == 0
         && (weakSideMinorPieces == 1 && weakSideMajorPieces == 0)) {
-        modifyForFactor<CalcJacobians>(params, params.rookVsMinorFactor, whiteEval);
-        return;
+        return DrawishCorrection::RookVsMinor;
     }
 
     // Rook and minor vs rook is drawish.
     if (strongSideRooks == 1 && strongSideQueens == 0 && strongSideMinorPieces == 1
         && weakSideRooks == 1 && weakSideQueens == 0 && weakSideMinorPieces == 0) {
-        modifyForFactor<CalcJacobians>(params, params.rookAndMinorVsRookFactor, whiteEval);
-        return;
+        return DrawishCorrection::RookAndMinorVsRook;
+    }
+
+    return DrawishCorrection::None;
+}
+
+[[nodiscard]] FORCE_INLINE std::pair<bool, bool> insufficientMaterialForSides(
+        const MaterialKey& materialKey) {
+    bool whiteInsufficientMaterial = false;
+    bool blackInsufficientMaterial = false;
+
+    const bool whiteOnlyHasMinorPieces = materialKey.hasNone(Side::White, Piece::Pawn)
+                                      && materialKey.hasNone(Side::White, Piece::Rook)
+                                      && materialKey.hasNone(Side::White, Piece::Queen);
+
+    const int numWhiteKnights = materialKey.getCount(Side::White, Piece::Knight);
+    const int numWhiteBishops = materialKey.getCount(Side::White, Piece::Bishop);
+
+    const bool whiteOnlyHasAKing =
+            whiteOnlyHasMinorPieces && numWhiteKnights == 0 && numWhiteBishops == 0;
+
+    const bool blackOnlyHasMinorPieces = materialKey.hasNone(Side::Black, Piece::Pawn)
+                                      && materialKey.hasNone(Side::Black, Piece::Rook)
+                                      && materialKey.hasNone(Side::Black, Piece::Queen);
+
+    const int numBlackKnights = materialKey.getCount(Side::Black, Piece::Knight);
+    const int numBlackBishops = materialKey.getCount(Side::Black, Piece::Bishop);
+
+    const bool blackOnlyHasAKing =
+            blackOnlyHasMinorPieces && numBlackKnights == 0 && numBlackBishops == 0;
+
+    if (whiteOnlyHasMinorPieces) {
+        if (numWhiteKnights == 0 && numWhiteBishops <= 1) {
+            whiteInsufficientMaterial = true;
+        } else if (numWhiteBishops == 0 && numWhiteKnights <= 1) {
+            whiteInsufficientMaterial = true;
+        }
     }
+
+    if (blackOnlyHasMinorPieces) {
+        if (numBlackKnights == 0 && numBlackBishops <= 1) {
+            blackInsufficientMaterial = true;
+        } else if (numBlackBishops == 0 && numBlackKnights <= 1) {
+            blackInsufficientMaterial = true;
+        }
+    }
+
+    if (whiteOnlyHasAKing && blackOnlyHasMinorPieces && numBlackBishops == 0
+        && numBlackKnights == 2) {
+        blackInsufficientMaterial = true;
+    }
+
+    if (blackOnlyHasAKing && whiteOnlyHasMinorPieces && numWhiteBishops == 0
+        && numWhiteKnights == 2) {
+        whiteInsufficientMaterial = true;
+    }
+
+    return {whiteInsufficientMaterial, blackInsufficientMaterial};
+}
+
+[[nodiscard]] bool hasOnlyKing(const MaterialKey& materialKey, const Side side) {
+    return materialKey.hasNone(side, Piece::Pawn) && materialKey.hasNone(side, Piece::Knight)
+        && materialKey.hasNone(side, Piece::Bishop) && materialKey.hasNone(side, Piece::Rook)
+        && materialKey.hasNone(side, Piece::Queen);
+}
+
+[[nodiscard]] SpecializedEndgame getSpecializedEndgame(
+        const MaterialKey& materialKey, const Side strongerSide) {
+    if (!hasOnlyKing(materialKey, nextSide(strongerSide))) {
+        return SpecializedEndgame::None;
+    }
+
+    if (materialKey.hasNone(strongerSide, Piece::Pawn)
+        && materialKey.getCount(strongerSide, Piece::Knight) == 1
+        && materialKey.getCount(strongerSide, Piece::Bishop) == 1
+        && materialKey.hasNone(strongerSide, Piece::Rook)
+        && materialKey.hasNone(strongerSide, Piece::Queen)) {
+        return SpecializedEndgame::KnightBishopVsKing;
+    }
+
+    return SpecializedEndgame::None;
+}
+
+[[nodiscard]] MaterialInfo computeMaterialInfo(
+        const MaterialKey& materialKey, const EvalParams& params) {
+    MaterialInfo info{};
+
+    for (const Side side : {Side::White, Side::Black}) {
+        info.drawishCorrections[(int)side] = getDrawishCorrection(materialKey, side);
+
+        const SpecializedEndgame specializedEndgame = getSpecializedEndgame(materialKey, side);
+        if (specializedEndgame != SpecializedEndgame::None) {
+            info.specializedEndgame             = specializedEndgame;
+            info.specializedEndgameStrongerSide = side;
+        }
+    }
+
+    const auto [whiteInsufficientMaterial, blackInsufficientMaterial] =
+            insufficientMaterialForSides(materialKey);
+    info.insufficientMaterial = {whiteInsufficientMaterial, blackInsufficientMaterial};
+
+    const int pawnDelta = std::abs(
+            materialKey.getCount(Side::White, Piece::Pawn)
+            - materialKey.getCount(Side::Black, Piece::Pawn));
+    info.oppositeColoredBishopFactorIdx =
+            (std::uint8_t)min(pawnDelta, (int)params.oppositeColoredBishopFactor.size() - 1);
+
+    return info;
+}
+
+template <bool CalcJacobians>
+FORCE_INLINE void correctForDrawish(
+        const MaterialInfo& materialInfo,
+        const Evaluator::EvalCalcParams& params,
+        TermWithGradient<CalcJacobians>& whiteEval) {
+    const Side strongerSide = whiteEval.value >= 0 ? Side::White : Side::Black;
+
+    switch (materialInfo.drawishCorrections[(int)strongerSide]) {
+        case DrawishCorrection::None:
+            return;
+        case DrawishCorrection::OppositeColoredBishops:
+            modifyForFactor<CalcJacobians>(
+                    params,
+                    params.oppositeColoredBishopFactor[materialInfo.oppositeColoredBishopFactorIdx],
+                    whiteEval);
+            return;
+        case DrawishCorrection::SingleMinor:
+            modifyForFactor<CalcJacobians>(params, params.singleMinorFactor, whiteEval);
+            return;
+        case DrawishCorrection::TwoKnights:
+            modifyForFactor<CalcJacobians>(params, params.twoKnightsFactor, whiteEval);
+            return;
+        case DrawishCorrection::RookVsMinor:
+            modifyForFactor<CalcJacobians>(params, params.rookVsMinorFactor, whiteEval);
+            return;
+        case DrawishCorrection::RookAndMinorVsRook:
+            modifyForFactor<CalcJacobians>(params, params.rookAndMinorVsRookFactor, whiteEval);
+            return;
+    }
+    UNREACHABLE;
+}
+
+// Evaluation of KBN vs K from the stronger side's perspective, on top of the regular evaluation.
+// The weaker king can only be mated in a corner of the bishop's color, so push it there and bring
+// the stronger king closer.
+[[nodiscard]] int evaluateKnightBishopVsKing(const GameState& gameState, const Side strongerSide) {
+    static constexpr int kCornerDistanceBonus = 20;
+    static constexpr int kKingDistanceBonus   = 10;
+
+    const Side weakerSide = nextSide(strongerSide);
+
+    const BoardPosition strongKingPosition =
+            getFirstSetPosition(gameState.getPieceBitBoard(strongerSide, Piece::King));
+    const BoardPosition weakKingPosition =
+            getFirstSetPosition(gameState.getPieceBitBoard(weakerSide, Piece::King));
+
+    // a1 and h8 have square color 0.
+    const bool bishopOnColor0 = gameState.getMaterialKey().getBishopCount(strongerSide, 0) > 0;
+    const BoardPosition corner1 =
+            bishopOnColor0 ? positionFromFileRank(0, 0) : positionFromFileRank(7, 0);
+    const BoardPosition corner2 =
+            bishopOnColor0 ? positionFromFileRank(7, 7) : positionFromFileRank(0, 7);
+
+    const int cornerDistance = min(
+            getChebyshevDistance(weakKingPosition, corner1),
+            getChebyshevDistance(weakKingPosition, corner2));
+    const int kingDistance = getChebyshevDistance(strongKingPosition, weakKingPosition);
+
+    return kCornerDistanceBonus * (7 - cornerDistance) + kKingDistanceBonus * (7 - kingDistance);
+}
+
+template <bool CalcJacobians>
+FORCE_INLINE void applySpecializedEndgame(
+        const MaterialInfo& materialInfo,
+        const GameState& gameState,
+        TermWithGradient<CalcJacobians>& whiteEval) {
+    const Side strongerSide = materialInfo.specializedEndgameStrongerSide;
+    const EvalCalcT sign    = strongerSide == Side::White ? 1.f : -1.f;
+
+    switch (materialInfo.specializedEndgame) {
+        case SpecializedEndgame::None:
+            return;
+        case SpecializedEndgame::KnightBishopVsKing:
+            // This doesn't depend on the eval params, so the gradient is unaffected.
+            whiteEval.value += sign * evaluateKnightBishopVsKing(gameState, strongerSide);
+            return;
+    }
+    UNREACHABLE;
 }
 
 [[nodiscard]] FORCE_INLINE BoardPosition
@@ -1124,8 +1334,8 @@ FORCE_INLINE void evaluateUnstoppablePawn(
     result.eval.late.value += params.hasUnstoppablePawn;
     if constexpr (CalcJacobians) {
         const auto paramIdx = params.getParamIndex(params.hasUnstoppablePawn);
-        result.eval.early.grad[paramIdx] += 1;
-        result.eval.late.grad[paramIdx] += 1;
+        addToGradient(result.eval.early.grad, paramIdx, 1);
+        addToGradient(result.eval.late.grad, paramIdx, 1);
     }
 }
 
@@ -1277,12 +1487,18 @@ FORCE_INLINE void evaluatePawnKingOrRetrieve(
                      + 2 * 1 * evalParams.phaseMaterialValues[(int)Piece::King];
     */
     ParamGradient<true> gradient = zeroGradient<true>();
-    gradient[params.getParamIndex(params.phaseMaterialValues[(int)Piece::Pawn])] += 2 * 8;
-    gradient[params.getParamIndex(params.phaseMaterialValues[(int)Piece::Knight])] += 2 * 2;
-    gradient[params.getParamIndex(params.phaseMaterialValues[(int)Piece::Bishop])] += 2 * 2;
-    gradient[params.getParamIndex(params.phaseMaterialValues[(int)Piece::Rook])] += 2 * 2;
-    gradient[params.getParamIndex(params.phaseMaterialValues[(int)Piece::Queen])] += 2 * 1;
-    gradient[params.getParamIndex(params.phaseMaterialValues[(int)Piece::King])] += 2 * 1;
+    addToGradient(
+            gradient, params.getParamIndex(params.phaseMaterialValues[(int)Piece::Pawn]), 2 * 8);
+    addToGradient(
+            gradient, params.getParamIndex(params.phaseMaterialValues[(int)Piece::Knight]), 2 * 2);
+    addToGradient(
+            gradient, params.getParamIndex(params.phaseMaterialValues[(int)Piece::Bishop]), 2 * 2);
+    addToGradient(
+            gradient, params.getParamIndex(params.phaseMaterialValues[(int)Piece::Rook]), 2 * 2);
+    addToGradient(
+            gradient, params.getParamIndex(params.phaseMaterialValues[(int)Piece::Queen]), 2 * 1);
+    addToGradient(
+            gradient, params.getParamIndex(params.phaseMaterialValues[(int)Piece::King]), 2 * 1);
     return gradient;
 }
 
@@ -1294,18 +1510,6 @@ FORCE_INLINE void evaluatePawnKingOrRetrieve(
     return earlyValue * earlyFactor + lateValue * lateFactor;
 }
 
-[[nodiscard]] ParamGradient<true> calcTaperedGradient(
-        const VectorT& earlyGradient,
-        const VectorT& lateGradient,
-        const VectorT& earlyFactorGradient,
-        const EvalCalcT earlyValue,
-        const EvalCalcT lateValue,
-        const EvalCalcT earlyFactor,
-        const EvalCalcT lateFactor) {
-    return earlyGradient * earlyFactor + earlyFactorGradient * earlyValue
-         + lateGradient * lateFactor - earlyFactorGradient * lateValue;
-}
-
 template <bool CalcJacobians>
 [[nodiscard]] FORCE_INLINE std::tuple<float, float, ParamGradient<CalcJacobians>> calcTaperParams(
         const Evaluator::EvalCalcParams& params,
@@ -1318,16 +1522,21 @@ template <bool CalcJacobians>
 
     ParamGradient<CalcJacobians> earlyFactorGradient;
     if constexpr (CalcJacobians) {
-        const ParamGradient<CalcJacobians> phaseMaterialGradient =
-                whitePiecePositionEval.phaseMaterial.grad
-                + blackPiecePositionEval.phaseMaterial.grad;
+        // earlyFactor = phaseMaterial / maxPhaseMaterial
+        const double maxPhaseMaterial = params.maxPhaseMaterial_;
 
-        const ParamGradient<CalcJacobians> maxPhaseMaterialGradient =
-                getMaxPhaseMaterialGradient(params);
-
-        earlyFactorGradient = (phaseMaterialGradient * params.maxPhaseMaterial_
-                               - phaseMaterial * maxPhaseMaterialGradient)
-                            / (params.maxPhaseMaterial_ * params.maxPhaseMaterial_);
+        addScaledGradient(
+                earlyFactorGradient,
+                whitePiecePositionEval.phaseMaterial.grad,
+                1. / maxPhaseMaterial);
+        addScaledGradient(
+                earlyFactorGradient,
+                blackPiecePositionEval.phaseMaterial.grad,
+                1. / maxPhaseMaterial);
+        addScaledGradient(
+                earlyFactorGradient,
+                getMaxPhaseMaterialGradient(params),
+                -phaseMaterial / (maxPhaseMaterial * maxPhaseMaterial));
     }
 
     return {earlyFactor, lateFactor, earlyFactorGradient};
@@ -1350,20 +1559,17 @@ template <bool CalcJacobians>
     result.value = calcTaperedValue(earlyEval, lateEval, earlyFactor, lateFactor);
 
     if constexpr (CalcJacobians) {
-        const ParamGradient<CalcJacobians> earlyEvalGradient =
-                whitePiecePositionEval.eval.early.grad - blackPiecePositionEval.eval.early.grad;
-
-        const ParamGradient<CalcJacobians> lateEvalGradient =
-                whitePiecePositionEval.eval.late.grad - blackPiecePositionEval.eval.late.grad;
-
-        result.grad = calcTaperedGradient(
-                earlyEvalGradient,
-                lateEvalGradient,
-                earlyFactorGradient,
-                earlyEval,
-                lateEval,
-                earlyFactor,
-                lateFactor);
+        // lateFactor = 1 - earlyFactor, so its gradient is the negated early factor gradient.
+        result.grad.reserve(
+                whitePiecePositionEval.eval.early.grad.size()
+                + blackPiecePositionEval.eval.early.grad.size()
+                + whitePiecePositionEval.eval.late.grad.size()
+                + blackPiecePositionEval.eval.late.grad.size() + earlyFactorGradient.size() + 1);
+        addScaledGradient(result.grad, whitePiecePositionEval.eval.early.grad, earlyFactor);
+        addScaledGradient(result.grad, blackPiecePositionEval.eval.early.grad, -earlyFactor);
+        addScaledGradient(result.grad, whitePiecePositionEval.eval.late.grad, lateFactor);
+        addScaledGradient(result.grad, blackPiecePositionEval.eval.late.grad, -lateFactor);
+        addScaledGradient(result.grad, earlyFactorGradient, earlyEval - lateEval);
     }
 
     return result;
@@ -1417,7 +1623,9 @@ template <bool CalcJacobians>
         const Evaluator::EvalCalcParams& params,
         const GameState& gameState,
         const BoardControl& boardControl,
-        PawnKingEvalHashTable& pawnKingEvalHashTable) {
+        PawnKingEvalHashTable& pawnKingEvalHashTable,
+        MaterialTable& materialTable) {
+    const MaterialInfo materialInfo = materialTable.probe(gameState.getMaterialKey(), params);
 
     const BoardPosition whiteKingPosition =
             getFirstSetPosition(gameState.getPieceBitBoard(Side::White, Piece::King));
@@ -1506,81 +1714,18 @@ template <bool CalcJacobians>
             lateFactor,
             earlyFactorGradient);
 
-    correctForDrawish<CalcJacobians>(gameState, params, taperedEval);
+    correctForDrawish<CalcJacobians>(materialInfo, params, taperedEval);
 
-    return taperedEval;
-}
+    applySpecializedEndgame<CalcJacobians>(materialInfo, gameState, taperedEval);
 
-[[nodiscard]] FORCE_INLINE std::pair<bool, bool> insufficientMaterialForSides(
-        const GameState& gameState) {
-    bool whiteInsufficientMaterial = false;
-    bool blackInsufficientMaterial = false;
-
-    const bool noWhitePawns =
-            gameState.getPieceBitBoard(Side::White, Piece::Pawn) == BitBoard::Empty;
-    const bool noWhiteRooks =
-            gameState.getPieceBitBoard(Side::White, Piece::Rook) == BitBoard::Empty;
-    const bool noWhiteQueens =
-            gameState.getPieceBitBoard(Side::White, Piece::Queen) == BitBoard::Empty;
-
-    const bool whiteOnlyHasMinorPieces = noWhitePawns && noWhiteRooks && noWhiteQueens;
-
-    const int numWhiteKnights = popCount(gameState.getPieceBitBoard(Side::White, Piece::Knight));
-    const int numWhiteBishops = popCount(gameState.getPieceBitBoard(Side::White, Piece::Bishop));
-
-    const bool whiteOnlyHasAKing =
-            whiteOnlyHasMinorPieces && numWhiteKnights == 0 && numWhiteBishops == 0;
-
-    const bool noBlackPawns =
-            gameState.getPieceBitBoard(Side::Black, Piece::Pawn) == BitBoard::Empty;
-    const bool noBlackRooks =
-            gameState.getPieceBitBoard(Side::Black, Piece::Rook) == BitBoard::Empty;
-    const bool noBlackQueens =
-            gameState.getPieceBitBoard(Side::Black, Piece::Queen) == BitBoard::Empty;
-
-    const bool blackOnlyHasMinorPieces = noBlackPawns && noBlackRooks && noBlackQueens;
-
-    const int numBlackKnights = popCount(gameState.getPieceBitBoard(Side::Black, Piece::Knight));
-    const int numBlackBishops = popCount(gameState.getPieceBitBoard(Side::Black, Piece::Bishop));
-
-    const bool blackOnlyHasAKing =
-            blackOnlyHasMinorPieces && numBlackKnights == 0 && numBlackBishops == 0;
-
-    if (whiteOnlyHasMinorPieces) {
-        if (numWhiteKnights == 0 && numWhiteBishops <= 1) {
-            whiteInsufficientMaterial = true;
-        } else if (numWhiteBishops == 0 && numWhiteKnights <= 1) {
-            whiteInsufficientMaterial = true;
-        }
-    }
-
-    if (blackOnlyHasMinorPieces) {
-        if (numBlackKnights == 0 && numBlackBishops <= 1) {
-            blackInsufficientMaterial = true;
-        } else if (numBlackBishops == 0 && numBlackKnights <= 1) {
-            blackInsufficientMaterial = true;
-        }
-    }
-
-    if (whiteOnlyHasAKing && blackOnlyHasMinorPieces && numBlackBishops == 0
-        && numBlackKnights == 2) {
-        blackInsufficientMaterial = true;
-    }
-
-    if (blackOnlyHasAKing && whiteOnlyHasMinorPieces && numWhiteBishops == 0
-        && numWhiteKnights == 2) {
-        whiteInsufficientMaterial = true;
-    }
-
-    return {whiteInsufficientMaterial, blackInsufficientMaterial};
+    return taperedEval;
 }
 
 }  // namespace
 
 PawnKingEvalHashTable::PawnKingEvalHashTable(const bool nonEmpty) {
     if (nonEmpty) {
-        // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
-        data_ = std::make_unique<Entry[]>(kPawnKingHashTableEntries);
+        data_ = LargePageArray<Entry>(kPawnKingHashTableEntries);
     }
 }
 
@@ -1615,21 +1760,132 @@ FORCE_INLINE void PawnKingEvalHashTable::store(HashT hash, const PawnKingEvalInf
     entry.info   = info;
 }
 
-Evaluator::EvalCalcParams::EvalCalcParams(const EvalParams& evalParams)
-    : EvalParams(evalParams),
-      maxPhaseMaterial_(
-              2 * 8 * evalParams.phaseMaterialValues[(int)Piece::Pawn]
-              + 2 * 2 * evalParams.phaseMaterialValues[(int)Piece::Knight]
-              + 2 * 2 * evalParams.phaseMaterialValues[(int)Piece::Bishop]
-              + 2 * 2 * evalParams.phaseMaterialValues[(int)Piece::Rook]
-              + 2 * 1 * evalParams.phaseMaterialValues[(int)Piece::Queen]
-              + 2 * 1 * evalParams.phaseMaterialValues[(int)Piece::King]) {}
+MaterialTable::MaterialTable() {
+    // No valid material key has all bits set.
+    for (auto& entry : entries_) {
+        entry.store(~std::uint64_t{0}, std::memory_order_relaxed);
+    }
+}
+
+FORCE_INLINE MaterialInfo MaterialTable::probe(const MaterialKey& key, const EvalParams& params) {
+    // Fibonacci hashing: the counts are in the low bits of the key, so mix them into the high bits.
+    const std::size_t index =
+            (std::size_t)((key.getValue() * 0x9E3779B97F4A7C15ULL) >> (64 - kNumEntriesLog2));
+
+    // Relaxed atomic loads and stores compile to plain moves on x86-64.
+    const std::uint64_t entry = entries_[index].load(std::memory_order_relaxed);
+    if (MaterialKey::fromValue(entry & ((std::uint64_t{1} << kInfoShift) - 1)) == key) {
+        return unpackInfo(entry);
+    }
+
+    const MaterialInfo info = computeMaterialInfo(key, params);
+    entries_[index].store(key.getValue() | packInfo(info), std::memory_order_relaxed);
+
+    return info;
+}
+
+FORCE_INLINE std::uint64_t MaterialTable::packInfo(const MaterialInfo& info) {
+    static_assert(std::tuple_size_v<decltype(EvalParams::oppositeColoredBishopFactor)> <= 4);
+
+    const std::uint64_t packedInfo =
+            (std::uint64_t)info.drawishCorrections[(int)Side::White]
+            | (std::uint64_t)info.drawishCorrections[(int)Side::Black] << 4
+            | (std::uint64_t)info.oppositeColoredBishopFactorIdx << 8
+            | (std::uint64_t)info.insufficientMaterial[(int)Side::White] << 10
+            | (std::uint64_t)info.insufficientMaterial[(int)Side::Black] << 11
+            | (std::uint64_t)info.specializedEndgame << 12
+            | (std::uint64_t)info.specializedEndgameStrongerSide << 15;
+
+    return packedInfo << kInfoShift;
+}
+
+FORCE_INLINE MaterialInfo MaterialTable::unpackInfo(const std::uint64_t entry) {
+    const std::uint64_t packedInfo = entry >> kInfoShift;
+
+    return {.drawishCorrections =
+                    {(DrawishCorrection)(packedInfo & 0xF),
+                     (DrawishCorrection)(packedInfo >> 4 & 0xF)},
+            .oppositeColoredBishopFactorIdx = (std::uint8_t)(packedInfo >> 8 & 0x3),
+            .insufficientMaterial           = {(bool)(packedInfo >> 10 & 1),
+                                               (bool)(packedInfo >> 11 & 1)},
+            .specializedEndgame             = (SpecializedEndgame)(packedInfo >> 12 & 0x7),
+            .specializedEndgameStrongerSide = (Side)(packedInfo >> 15)};
+}
+
+EvalHashTable::EvalHashTable(const int sizeInMb) : sizeInMb_(sizeInMb) {
+    const std::size_t requestedEntries =
+            (std::size_t)sizeInMb * 1024 * 1024 / sizeof(std::uint64_t);
+    const std::size_t numEntries = std::bit_floor(std::max(requestedEntries, (std::size_t)1));
+
+    data_ = LargePageArray<std::uint64_t>(numEntries);
+    mask_ = numEntries - 1;
+}
+
+FORCE_INLINE std::optional<EvalT> EvalHashTable::probe(const HashT hash) const {
+    MY_ASSERT(!empty());
+
+    const std::uint64_t entry = data_[hash & mask_];
+    if ((entry ^ hash) >> kEvalBits == 0) {
+        return (EvalT)(std::uint16_t)entry;
+    }
+
+    return std::nullopt;
+}
+
+FORCE_INLINE void EvalHashTable::prefetch(const HashT hash) const {
+    MY_ASSERT(!empty());
+
+    ::prefetch(&data_[hash & mask_]);
+}
+
+FORCE_INLINE void EvalHashTable::store(const HashT hash, const EvalT eval) {
+    MY_ASSERT(!empty());
+
+    data_[hash & mask_] = (hash >> kEvalBits << kEvalBits) | (std::uint16_t)eval;
+}
 
 Evaluator::Evaluator(bool usePawnKingEvalHashTable)
     : Evaluator(EvalParams::getDefaultParams(), usePawnKingEvalHashTable) {}
 
-Evaluator::Evaluator(const EvalParams& params, bool usePawnKingEvalHashTable)
-    : params_(params), pawnKingEvalHashTable_(/*nonEmpty*/ usePawnKingEvalHashTable) {}
+Evaluator::Evaluator(
+        const EvalParams& params, bool usePawnKingEvalHashTable, const int evalHashTableSizeInMb)
+    : params_(params),
+      usesDefaultParams_(evalParamsToArray(params) == kDefaultEvalParamArray),
+      pawnKingEvalHashTable_(/*nonEmpty*/ usePawnKingEvalHashTable) {
+    setEvalHashTableSize(evalHashTableSizeInMb);
+}
+
+void Evaluator::attachNnueAccumulator(GameState& gameState) const {
+    gameState.setNnueNetwork(nnueNetwork_.get());
+}
+
+void Evaluator::setNnueNetwork(std::shared_ptr<const NnueNetwork> network) {
+    nnueNetwork_ = std::move(network);
+
+    // Cached evaluations are from the previous backend.
+    setEvalHashTableSize(getEvalHashTableSizeInMb());
+}
+
+void Evaluator::setEvalHashTableSize(const int sizeInMb) {
+    // Free the old table first so that the old and new tables don't need to fit in memory at the
+    // same time.
+    evalHashTable_ = EvalHashTable();
+    if (sizeInMb > 0) {
+        evalHashTable_ = EvalHashTable(sizeInMb);
+    }
+}
+
+EvalHashStatistics Evaluator::getEvalHashStatistics() const {
+    return {
+            .probes = evalHashProbes_.load(std::memory_order_relaxed),
+            .hits   = evalHashHits_.load(std::memory_order_relaxed),
+    };
+}
+
+void Evaluator::resetEvalHashStatistics() const {
+    evalHashProbes_.store(0, std::memory_order_relaxed);
+    evalHashHits_.store(0, std::memory_order_relaxed);
+}
 
 FORCE_INLINE int Evaluator::getPieceSquareValue(
         const Piece piece, BoardPosition position, const Side side) const {
@@ -1648,18 +1904,102 @@ FORCE_INLINE int Evaluator::getPieceSquareValue(
 
 EvalCalcT Evaluator::evaluateRaw(const GameState& gameState) const {
     const auto rawEvalWhite = evaluateForWhite<false>(
-            params_, gameState, gameState.getBoardControl(), pawnKingEvalHashTable_);
+            params_,
+            gameState,
+            gameState.getBoardControl(),
+            pawnKingEvalHashTable_,
+            materialTable_);
 
     return gameState.getSideToMove() == Side::White ? rawEvalWhite.value : -rawEvalWhite.value;
 }
 
 EvalWithGradient Evaluator::evaluateWithGradient(const GameState& gameState) const {
-    const auto rawEvalWhite = evaluateForWhite<true>(
-            params_, gameState, gameState.getBoardControl(), pawnKingEvalHashTable_);
+    auto rawEvalWhite = evaluateForWhite<true>(
+            params_,
+            gameState,
+            gameState.getBoardControl(),
+            pawnKingEvalHashTable_,
+            materialTable_);
 
     const EvalCalcT colorFactor = gameState.getSideToMove() == Side::White ? 1.f : -1.f;
 
-    return {.eval = colorFactor * rawEvalWhite.value, .gradient = colorFactor * rawEvalWhite.grad};
+    compactGradient(rawEvalWhite.grad);
+    scaleGradient(rawEvalWhite.grad, colorFactor);
+
+    return {.eval = colorFactor * rawEvalWhite.value, .gradient = std::move(rawEvalWhite.grad)};
+}
+
+// The pawn-king and eval hash tables can't be shared between threads, so threads other than the
+// calling thread get their own evaluator with the same params if this evaluator uses them. The
+// material table can be shared: its entries are single relaxed atomic words.
+template <typename OutputT, typename EvaluateChunkFuncT>
+// NOLINTNEXTLINE(cppcoreguidelines-missing-std-forward), see https://joelfilho.com/blog/2020/forwarding_references/
+void Evaluator::evaluateBatchInParallel(
+        const std::span<const GameState> gameStates,
+        const std::span<OutputT> outputs,
+        const int numThreads,
+        EvaluateChunkFuncT&& evaluateChunk) const {
+    MY_ASSERT(gameStates.size() == outputs.size());
+
+    const bool needsThreadEvaluators = !pawnKingEvalHashTable_.empty() || !evalHashTable_.empty();
+
+    parallelForChunks(
+            gameStates.size(),
+            numThreads,
+            [&](const std::size_t begin, const std::size_t end) {
+                std::optional<Evaluator> threadEvaluator;
+                if (begin != 0 && needsThreadEvaluators) {
+                    threadEvaluator.emplace(params_, usesPawnKingEvalHashTable());
+                    threadEvaluator->setNnueNetwork(nnueNetwork_);
+                }
+
+                evaluateChunk(
+                        threadEvaluator ? *threadEvaluator : *this,
+                        gameStates.subspan(begin, end - begin),
+                        outputs.subspan(begin, end - begin));
+            });
+}
+
+void Evaluator::evaluateBatch(
+        const std::span<const GameState> gameStates,
+        const std::span<EvalT> evals,
+        const int numThreads) const {
+    evaluateBatchInParallel(
+            gameStates,
+            evals,
+            numThreads,
+            [](const Evaluator& evaluator,
+               const std::span<const GameState> chunkGameStates,
+               const std::span<EvalT> chunkEvals) {
+                for (std::size_t i = 0; i < chunkGameStates.size(); ++i) {
+                    if (i + kBatchPrefetchDistance < chunkGameStates.size()) {
+                        evaluator.prefetch(chunkGameStates[i + kBatchPrefetchDistance]);
+                    }
+
+                    chunkEvals[i] = evaluator.evaluate(chunkGameStates[i]);
+                }
+            });
+}
+
+void Evaluator::evaluateWithGradientBatch(
+        const std::span<const GameState> gameStates,
+        const std::span<EvalWithGradient> evals,
+        const int numThreads) const {
+    evaluateBatchInParallel(
+            gameStates,
+            evals,
+            numThreads,
+            [](const Evaluator& evaluator,
+               const std::span<const GameState> chunkGameStates,
+               const std::span<EvalWithGradient> chunkEvals) {
+                for (std::size_t i = 0; i < chunkGameStates.size(); ++i) {
+                    if (i + kBatchPrefetchDistance < chunkGameStates.size()) {
+                        evaluator.prefetch(chunkGameStates[i + kBatchPrefetchDistance]);
+                    }
+
+                    chunkEvals[i] = evaluator.evaluateWithGradient(chunkGameStates[i]);
+                }
+            });
 }
 
 FORCE_INLINE EvalT Evaluator::evaluate(const GameState& gameState) const {
@@ -1667,16 +2007,78 @@ FORCE_INLINE EvalT Evaluator::evaluate(const GameState& gameState) const {
 }
 
 EvalT Evaluator::evaluate(const GameState& gameState, const BoardControl& boardControl) const {
-    const auto rawEvalWhite =
-            evaluateForWhite<false>(params_, gameState, boardControl, pawnKingEvalHashTable_);
+    const bool useEvalHashTable = !evalHashTable_.empty();
+
+    if (useEvalHashTable) {
+        // Only the evaluating thread writes the counters, so we can avoid a (locked)
+        // read-modify-write.
+        evalHashProbes_.store(
+                evalHashProbes_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        if (const auto cachedEval = evalHashTable_.probe(gameState.getBoardHash())) {
+            evalHashHits_.store(
+                    evalHashHits_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return *cachedEval;
+        }
+    }
+
+    EvalT eval;
+    if (nnueNetwork_) {
+        eval = evaluateNnue(gameState);
+    } else {
+        const auto rawEvalWhite =
+                kUseConstexprEvalParams && usesDefaultParams_
+                        ? evaluateForWhite<false>(
+                                  kDefaultEvalCalcParams,
+                                  gameState,
+                                  boardControl,
+                                  pawnKingEvalHashTable_,
+                                  materialTable_)
+                        : evaluateForWhite<false>(
+                                  params_,
+                                  gameState,
+                                  boardControl,
+                                  pawnKingEvalHashTable_,
+                                  materialTable_);
+
+        const EvalT clampedEvalWhite =
+                (EvalT)clamp((int)rawEvalWhite.value, -kMateEval + 1'000, kMateEval - 1'000);
+
+        eval = gameState.getSideToMove() == Side::White ? clampedEvalWhite : -clampedEvalWhite;
+    }
+
+    if (useEvalHashTable) {
+        evalHashTable_.store(gameState.getBoardHash(), eval);
+    }
+
+    return eval;
+}
+
+FORCE_INLINE bool Evaluator::isInsufficientMaterial(const GameState& gameState) const {
+    const MaterialInfo materialInfo = materialTable_.probe(gameState.getMaterialKey(), params_);
+
+    return materialInfo.insufficientMaterial[(int)Side::White]
+        && materialInfo.insufficientMaterial[(int)Side::Black];
+}
 
-    const EvalT clampedEvalWhite =
-            (EvalT)clamp((int)rawEvalWhite.value, -kMateEval + 1'000, kMateEval - 1'000);
+EvalT Evaluator::evaluateNnue(const GameState& gameState) const {
+    int eval;
+    if (gameState.getNnueNetwork() == nnueNetwork_.get()) {
+        eval = nnueNetwork_->evaluate(gameState.getNnueAccumulator(), gameState.getSideToMove());
+    } else {
+        NnueAccumulator accumulator;
+        nnueNetwork_->refreshAccumulator(accumulator, gameState);
+        eval = nnueNetwork_->evaluate(accumulator, gameState.getSideToMove());
+    }
 
-    return gameState.getSideToMove() == Side::White ? clampedEvalWhite : -clampedEvalWhite;
+    return (EvalT)clamp(eval, -kMateEval + 1'000, kMateEval - 1'000);
 }
 
 FORCE_INLINE void Evaluator::prefetch(const GameState& gameState) const {
+    if (!evalHashTable_.empty()) {
+        evalHashTable_.prefetch(gameState.getBoardHash());
+    }
+
     if (pawnKingEvalHashTable_.empty()) {
         return;
     }
@@ -1701,7 +2103,7 @@ FORCE_INLINE int getStaticPieceValue(const Piece piece) {
 
 FORCE_INLINE bool isInsufficientMaterial(const GameState& gameState) {
     const auto [whiteInsufficientMaterial, blackInsufficientMaterial] =
-            insufficientMaterialForSides(gameState);
+            insufficientMaterialForSides(gameState.getMaterialKey());
 
     return whiteInsufficientMaterial && blackInsufficientMaterial;
 }
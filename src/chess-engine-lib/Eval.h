@@ -3,15 +3,31 @@
 #include "EvalParams.h"
 #include "EvalT.h"
 #include "GameState.h"
+#include "LargePages.h"
+#include "Nnue.h"
 
+#include <array>
+#include <atomic>
 #include <memory>
-#include <valarray>
+#include <span>
+#include <vector>
 
-using VectorT = std::valarray<double>;
+#include <cstddef>
+#include <cstdint>
+
+// Partial derivative of an evaluation with respect to one of the eval params.
+struct GradientEntry {
+    std::uint32_t paramIdx;
+    double derivative;
+};
+
+// Gradient of an evaluation with respect to the eval params, as a list of partial derivatives
+// sorted by param index. Params that aren't listed have a zero derivative.
+using SparseGradient = std::vector<GradientEntry>;
 
 struct EvalWithGradient {
     EvalCalcT eval;
-    VectorT gradient;
+    SparseGradient gradient;
 };
 
 using PstMapping = std::array<std::int8_t, kSquares>;
@@ -39,7 +55,7 @@ class PawnKingEvalHashTable {
 
     void store(HashT hash, const PawnKingEvalInfo& info);
 
-    [[nodiscard]] bool empty() const { return data_ == nullptr; }
+    [[nodiscard]] bool empty() const { return data_.empty(); }
 
   private:
     struct Entry {
@@ -47,20 +63,119 @@ class PawnKingEvalHashTable {
         PawnKingEvalInfo info{};
     };
 
-    // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
-    std::unique_ptr<Entry[]> data_;
+    LargePageArray<Entry> data_;
+};
+
+// Cache of full static evaluations, keyed by board hash. The board hash includes the side to move,
+// so the side-relative evaluation can be stored directly.
+class EvalHashTable {
+  public:
+    // Construct an empty (disabled) table.
+    EvalHashTable() = default;
+
+    explicit EvalHashTable(int sizeInMb);
+
+    [[nodiscard]] std::optional<EvalT> probe(HashT hash) const;
+
+    void prefetch(HashT hash) const;
+
+    void store(HashT hash, EvalT eval);
+
+    [[nodiscard]] bool empty() const { return data_.empty(); }
+
+    [[nodiscard]] int getSizeInMb() const { return sizeInMb_; }
+
+  private:
+    // Each entry packs the upper 48 bits of the hash with the eval in the lower 16 bits.
+    static constexpr int kEvalBits = 16;
+
+    LargePageArray<std::uint64_t> data_;
+    std::size_t mask_ = 0;
+    int sizeInMb_     = 0;
+};
+
+// Material configurations in which the eval is scaled towards a draw.
+enum class DrawishCorrection : std::uint8_t {
+    None,
+    OppositeColoredBishops,
+    SingleMinor,
+    TwoKnights,
+    RookVsMinor,
+    RookAndMinorVsRook,
+};
+
+// Material configurations with a dedicated evaluation function, applied on top of the regular
+// evaluation.
+enum class SpecializedEndgame : std::uint8_t {
+    None,
+    // King, bishop and knight vs king: drive the king to a corner of the bishop's color.
+    KnightBishopVsKing,
+};
+
+// Evaluation info that only depends on the material on the board.
+struct MaterialInfo {
+    // The correction to apply if white or black (respectively) is the stronger side.
+    std::array<DrawishCorrection, kNumSides> drawishCorrections{};
+
+    // Index into oppositeColoredBishopFactor, for DrawishCorrection::OppositeColoredBishops.
+    std::uint8_t oppositeColoredBishopFactorIdx = 0;
+
+    // Whether white or black (respectively) can't possibly deliver checkmate.
+    std::array<bool, kNumSides> insufficientMaterial{};
+
+    SpecializedEndgame specializedEndgame = SpecializedEndgame::None;
+    // The side with the material advantage in specializedEndgame.
+    Side specializedEndgameStrongerSide = Side::White;
+};
+
+// Small cache of MaterialInfo, keyed by material key. The number of distinct material
+// configurations in a search is small, so this almost always hits.
+class MaterialTable {
+  public:
+    MaterialTable();
+
+    [[nodiscard]] MaterialInfo probe(const MaterialKey& key, const EvalParams& params);
+
+  private:
+    static constexpr int kNumEntriesLog2 = 10;
+
+    // Each entry packs the material key in the lower bits with the info in the upper 16 bits, so
+    // that a single relaxed atomic load always sees a matching key and info. This lets an
+    // evaluator without hash tables be shared between threads.
+    static constexpr int kInfoShift = MaterialKey::kNumBits;
+
+    [[nodiscard]] static std::uint64_t packInfo(const MaterialInfo& info);
+    [[nodiscard]] static MaterialInfo unpackInfo(std::uint64_t entry);
+
+    std::array<std::atomic<std::uint64_t>, 1 << kNumEntriesLog2> entries_;
+};
+
+struct EvalHashStatistics {
+    std::uint64_t probes = 0;
+    std::uint64_t hits   = 0;
 };
 
 class Evaluator {
   public:
     struct EvalCalcParams : EvalParams {
-        EvalCalcParams(const EvalParams& evalParams);
+        constexpr EvalCalcParams(const EvalParams& evalParams)
+            : EvalParams(evalParams),
+              maxPhaseMaterial_(
+                      2 * 8 * evalParams.phaseMaterialValues[(int)Piece::Pawn]
+                      + 2 * 2 * evalParams.phaseMaterialValues[(int)Piece::Knight]
+                      + 2 * 2 * evalParams.phaseMaterialValues[(int)Piece::Bishop]
+                      + 2 * 2 * evalParams.phaseMaterialValues[(int)Piece::Rook]
+                      + 2 * 1 * evalParams.phaseMaterialValues[(int)Piece::Queen]
+                      + 2 * 1 * evalParams.phaseMaterialValues[(int)Piece::King]) {}
 
         EvalCalcT maxPhaseMaterial_{};
     };
 
     explicit Evaluator(bool usePawnKingEvalHashTable = false);
-    explicit Evaluator(const EvalParams& params, bool usePawnKingEvalHashTable = false);
+    explicit Evaluator(
+            const EvalParams& params,
+            bool usePawnKingEvalHashTable = false,
+            int evalHashTableSizeInMb     = 0);
 
     [[nodiscard]] int getPieceSquareValue(Piece piece, BoardPosition position, Side side) const;
 
@@ -72,12 +187,80 @@ class Evaluator {
     [[nodiscard]] EvalT evaluate(
             const GameState& gameState, const BoardControl& boardControl) const;
 
+    // As the free function isInsufficientMaterial, but cached in the material table.
+    [[nodiscard]] bool isInsufficientMaterial(const GameState& gameState) const;
+
+    // Evaluate each of gameStates into the corresponding element of evals, as evaluate would. With
+    // numThreads > 1, the positions are split into contiguous chunks that are evaluated in parallel.
+    void evaluateBatch(
+            std::span<const GameState> gameStates,
+            std::span<EvalT> evals,
+            int numThreads = 1) const;
+
+    // As evaluateBatch, but as evaluateWithGradient would.
+    void evaluateWithGradientBatch(
+            std::span<const GameState> gameStates,
+            std::span<EvalWithGradient> evals,
+            int numThreads = 1) const;
+
     void prefetch(const GameState& gameState) const;
 
+    [[nodiscard]] const EvalParams& getParams() const { return params_; }
+
+    [[nodiscard]] bool usesPawnKingEvalHashTable() const {
+        return !pawnKingEvalHashTable_.empty();
+    }
+
+    // A size of 0 disables the eval hash table.
+    void setEvalHashTableSize(int sizeInMb);
+
+    [[nodiscard]] int getEvalHashTableSizeInMb() const { return evalHashTable_.getSizeInMb(); }
+
+    // Statistics are only collected when the eval hash table is enabled. The counters may be read
+    // from a different thread than the one evaluating.
+    [[nodiscard]] EvalHashStatistics getEvalHashStatistics() const;
+
+    void resetEvalHashStatistics() const;
+
+    // Make gameState incrementally maintain the accumulator of this evaluator's NNUE network (or
+    // none, for the hand-crafted evaluation), so that evaluate doesn't need to recompute it.
+    void attachNnueAccumulator(GameState& gameState) const;
+
+    // Evaluate using network instead of the hand-crafted evaluation, or go back to the hand-crafted
+    // evaluation if network is nullptr. The gradient and raw evaluations always use the
+    // hand-crafted evaluation.
+    void setNnueNetwork(std::shared_ptr<const NnueNetwork> network);
+
+    [[nodiscard]] const std::shared_ptr<const NnueNetwork>& getNnueNetwork() const {
+        return nnueNetwork_;
+    }
+
   private:
+    [[nodiscard]] EvalT evaluateNnue(const GameState& gameState) const;
+
+    template <typename OutputT, typename EvaluateChunkFuncT>
+    void evaluateBatchInParallel(
+            std::span<const GameState> gameStates,
+            std::span<OutputT> outputs,
+            int numThreads,
+            EvaluateChunkFuncT&& evaluateChunk) const;
+
     EvalCalcParams params_;
 
+    // If the params are the default params and EUWE_CONSTEXPR_EVAL_PARAMS is defined, evaluate
+    // uses a version of the evaluation that's specialized for the default params at compile time.
+    // The raw and gradient evaluations always use the runtime params.
+    bool usesDefaultParams_;
+
+    std::shared_ptr<const NnueNetwork> nnueNetwork_;
+
     mutable PawnKingEvalHashTable pawnKingEvalHashTable_;
+
+    mutable MaterialTable materialTable_;
+
+    mutable EvalHashTable evalHashTable_;
+    mutable std::atomic<std::uint64_t> evalHashProbes_ = 0;
+    mutable std::atomic<std::uint64_t> evalHashHits_   = 0;
 };
 
 [[nodiscard]] int getStaticPieceValue(Piece piece);
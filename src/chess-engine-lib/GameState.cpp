@@ -3,8 +3,11 @@
 #include "Macros.h"
 #include "Math.h"
 #include "MyAssert.h"
+#include "Nnue.h"
 #include "PieceControl.h"
 
+#include <utility>
+
 namespace {
 
 [[nodiscard]] FORCE_INLINE BitBoard
@@ -17,33 +20,50 @@ getKingRayBitBoard(const BoardPosition piecePosition, const BoardPosition kingPo
     return kingRayBitBoard;
 }
 
+[[nodiscard]] FORCE_INLINE bool generatesCaptures(const MoveGenerationType type) {
+    return type != MoveGenerationType::Quiet;
+}
+
+[[nodiscard]] FORCE_INLINE bool generatesNonCaptures(const MoveGenerationType type) {
+    return type == MoveGenerationType::All || type == MoveGenerationType::Quiet;
+}
+
+template <Side SideToMove>
 void generatePawnMoves(
         const BitBoard pawnBitBoard,
-        const Side side,
         const std::array<BitBoard, kNumSides>& occupancy,
         const BoardPosition enPassantTarget,
         const BitBoard pinBitBoard,
         const BoardPosition kingPosition,
         StackVector<Move>& moves,
-        const bool capturesOnly,
+        const MoveGenerationType type,
         const BitBoard checkResolutionBitBoard = BitBoard::Full) {
-    const std::uint64_t startingRankMask =
-            side == Side::White ? (0xffULL << (1 * 8)) : (0xffULL << (6 * 8));
-    auto forwardShift = [=](const BitBoard bitBoard) FORCE_INLINE {
-        return side == Side::White ? (BitBoard)((std::uint64_t)bitBoard << 8)
-                                   : (BitBoard)((std::uint64_t)bitBoard >> 8);
+    constexpr std::uint64_t startingRankMask =
+            SideToMove == Side::White ? (0xffULL << (1 * 8)) : (0xffULL << (6 * 8));
+    auto forwardShift = [](const BitBoard bitBoard) FORCE_INLINE {
+        if constexpr (SideToMove == Side::White) {
+            return (BitBoard)((std::uint64_t)bitBoard << 8);
+        } else {
+            return (BitBoard)((std::uint64_t)bitBoard >> 8);
+        }
     };
-    auto leftForwardShift = [=](const BitBoard bitBoard) FORCE_INLINE {
-        return side == Side::White ? (BitBoard)(((std::uint64_t)bitBoard & kNotWestFileMask) << 7)
-                                   : (BitBoard)(((std::uint64_t)bitBoard & kNotWestFileMask) >> 9);
+    auto leftForwardShift = [](const BitBoard bitBoard) FORCE_INLINE {
+        if constexpr (SideToMove == Side::White) {
+            return (BitBoard)(((std::uint64_t)bitBoard & kNotWestFileMask) << 7);
+        } else {
+            return (BitBoard)(((std::uint64_t)bitBoard & kNotWestFileMask) >> 9);
+        }
     };
-    auto rightForwardShift = [=](const BitBoard bitBoard) FORCE_INLINE {
-        return side == Side::White ? (BitBoard)(((std::uint64_t)bitBoard & kNotEastFileMask) << 9)
-                                   : (BitBoard)(((std::uint64_t)bitBoard & kNotEastFileMask) >> 7);
+    auto rightForwardShift = [](const BitBoard bitBoard) FORCE_INLINE {
+        if constexpr (SideToMove == Side::White) {
+            return (BitBoard)(((std::uint64_t)bitBoard & kNotEastFileMask) << 9);
+        } else {
+            return (BitBoard)(((std::uint64_t)bitBoard & kNotEastFileMask) >> 7);
+        }
     };
 
     const BitBoard anyPiece = occupancy[0] | occupancy[1];
-    BitBoard captureTargets = occupancy[(int)nextSide(side)];
+    BitBoard captureTargets = occupancy[(int)nextSide(SideToMove)];
     if (enPassantTarget != BoardPosition::Invalid) {
         captureTargets |= enPassantTarget;
     }
@@ -54,12 +74,12 @@ void generatePawnMoves(
     leftCaptures  = leftCaptures & checkResolutionBitBoard;
     rightCaptures = rightCaptures & checkResolutionBitBoard;
 
-    const int forwardBits       = side == Side::White ? 8 : -8;
-    const int moveRankIncrement = side == Side::White ? 1 : -1;
-    constexpr int leftBits      = -1;
-    constexpr int rightBits     = 1;
+    constexpr int forwardBits       = SideToMove == Side::White ? 8 : -8;
+    constexpr int moveRankIncrement = SideToMove == Side::White ? 1 : -1;
+    constexpr int leftBits          = -1;
+    constexpr int rightBits         = 1;
 
-    const int promotionRank = side == Side::White ? 7 : 0;
+    constexpr int promotionRank = SideToMove == Side::White ? 7 : 0;
 
     enum class FileDelta : int {
         Left     = -1,
@@ -104,6 +124,13 @@ void generatePawnMoves(
             int toRank = rankFromPosition(targetPosition);
             if (toRank == promotionRank) {
                 for (const auto promotionPiece : kPromotionPieces) {
+                    if (type == MoveGenerationType::Tactical || type == MoveGenerationType::Quiet) {
+                        const bool isTactical =
+                                isCapture(flags) || promotionPiece == Piece::Queen;
+                        if (isTactical != (type == MoveGenerationType::Tactical)) {
+                            continue;
+                        }
+                    }
                     moves.emplace_back(
                             Piece::Pawn, originPosition, targetPosition, flags | promotionPiece);
                 }
@@ -113,7 +140,7 @@ void generatePawnMoves(
         }
     };
 
-    if (!capturesOnly) {
+    if (type != MoveGenerationType::CapturesOnly) {
         BitBoard singlePushes = forwardShift(pawnBitBoard) & ~anyPiece;
 
         const BitBoard startingPawns           = pawnBitBoard & (BitBoard)startingRankMask;
@@ -123,30 +150,38 @@ void generatePawnMoves(
         singlePushes = singlePushes & checkResolutionBitBoard;
         doublePushes = doublePushes & checkResolutionBitBoard;
 
+        if (type == MoveGenerationType::Tactical) {
+            // Only pushes to the promotion rank (and only queen promotions) are tactical.
+            singlePushes = singlePushes & (BitBoard)(0xffULL << (promotionRank * 8));
+            doublePushes = BitBoard::Empty;
+        }
+
         generateMoves(singlePushes, forwardBits, FileDelta::Straight, MoveFlags::None);
         generateMoves(doublePushes, 2 * forwardBits, FileDelta::Straight, MoveFlags::None);
     }
 
-    generateMoves(leftCaptures, forwardBits + leftBits, FileDelta::Left, MoveFlags::IsCapture);
-    generateMoves(rightCaptures, forwardBits + rightBits, FileDelta::Right, MoveFlags::IsCapture);
+    if (generatesCaptures(type)) {
+        generateMoves(leftCaptures, forwardBits + leftBits, FileDelta::Left, MoveFlags::IsCapture);
+        generateMoves(
+                rightCaptures, forwardBits + rightBits, FileDelta::Right, MoveFlags::IsCapture);
+    }
 }
 
+template <Side SideToMove>
 FORCE_INLINE void generateCastlingMoves(
-        const Side sideToMove,
         const bool canCastleKingSide,
         const bool canCastleQueenSide,
         const BitBoard anyPiece,
         const BitBoard enemyControlledSquares,
         StackVector<Move>& moves) {
-    MY_ASSERT(sideToMove == Side::White || sideToMove == Side::Black);
+    constexpr BoardPosition kingPosition =
+            SideToMove == Side::White ? BoardPosition::E1 : BoardPosition::E8;
 
-    const BoardPosition kingPosition =
-            sideToMove == Side::White ? BoardPosition::E1 : BoardPosition::E8;
-
-    const auto [kingFile, kingRank] = fileRankFromPosition(kingPosition);
+    constexpr int kingFile = fileFromPosition(kingPosition);
+    constexpr int kingRank = rankFromPosition(kingPosition);
 
     if (canCastleKingSide) {
-        const BitBoard emptySquaresMask = (BitBoard)(0x60ULL << (kingRank * 8));
+        constexpr BitBoard emptySquaresMask = (BitBoard)(0x60ULL << (kingRank * 8));
 
         bool castleIsValid = true;
         if ((emptySquaresMask & anyPiece) != BitBoard::Empty) {
@@ -157,13 +192,13 @@ FORCE_INLINE void generateCastlingMoves(
         }
 
         if (castleIsValid) {
-            const BoardPosition targetPosition = positionFromFileRank(kingFile + 2, kingRank);
+            constexpr BoardPosition targetPosition = positionFromFileRank(kingFile + 2, kingRank);
             moves.emplace_back(Piece::King, kingPosition, targetPosition, MoveFlags::IsCastle);
         }
     }
     if (canCastleQueenSide) {
-        const BitBoard emptySquaresMask = (BitBoard)(0xeULL << (kingRank * 8));
-        const BitBoard controlMask      = (BitBoard)(0x1cULL << (kingRank * 8));
+        constexpr BitBoard emptySquaresMask = (BitBoard)(0xeULL << (kingRank * 8));
+        constexpr BitBoard controlMask      = (BitBoard)(0x1cULL << (kingRank * 8));
 
         bool castleIsValid = true;
         if ((emptySquaresMask & anyPiece) != BitBoard::Empty) {
@@ -174,7 +209,7 @@ FORCE_INLINE void generateCastlingMoves(
         }
 
         if (castleIsValid) {
-            const BoardPosition targetPosition = positionFromFileRank(kingFile - 2, kingRank);
+            constexpr BoardPosition targetPosition = positionFromFileRank(kingFile - 2, kingRank);
             moves.emplace_back(Piece::King, kingPosition, targetPosition, MoveFlags::IsCastle);
         }
     }
@@ -188,17 +223,19 @@ FORCE_INLINE void generateSinglePieceMovesFromControl(
         const BitBoard ownPiece,
         const BitBoard enemyPiece,
         StackVector<Move>& moves,
-        bool capturesOnly) {
+        const MoveGenerationType type) {
     // Can't move to our own pieces
     controlledSquares = controlledSquares & ~ownPiece;
 
-    BitBoard captures = controlledSquares & enemyPiece;
-    while (captures != BitBoard::Empty) {
-        const BoardPosition capturePosition = popFirstSetPosition(captures);
-        moves.emplace_back(piece, piecePosition, capturePosition, MoveFlags::IsCapture);
+    if (generatesCaptures(type)) {
+        BitBoard captures = controlledSquares & enemyPiece;
+        while (captures != BitBoard::Empty) {
+            const BoardPosition capturePosition = popFirstSetPosition(captures);
+            moves.emplace_back(piece, piecePosition, capturePosition, MoveFlags::IsCapture);
+        }
     }
 
-    if (!capturesOnly) {
+    if (generatesNonCaptures(type)) {
         BitBoard nonCaptures = controlledSquares & ~enemyPiece;
         while (nonCaptures != BitBoard::Empty) {
             const BoardPosition movePosition = popFirstSetPosition(nonCaptures);
@@ -225,17 +262,65 @@ StackVector<Move> GameState::generateMoves(StackOfVectors<Move>& stack, bool cap
 
 StackVector<Move> GameState::generateMoves(
         StackOfVectors<Move>& stack, const BoardControl& boardControl, bool capturesOnly) const {
+    return generateMovesOfType(
+            stack,
+            boardControl,
+            capturesOnly ? MoveGenerationType::CapturesOnly : MoveGenerationType::All);
+}
+
+StackVector<Move> GameState::generateMovesInCheck(
+        StackOfVectors<Move>& stack, const BoardControl& boardControl, bool capturesOnly) const {
+    return generateMovesInCheckOfType(
+            stack,
+            boardControl,
+            capturesOnly ? MoveGenerationType::CapturesOnly : MoveGenerationType::All);
+}
+
+StackVector<Move> GameState::generateMovesOfType(
+        StackOfVectors<Move>& stack,
+        const BoardControl& boardControl,
+        const MoveGenerationType type) const {
+    return sideToMove_ == Side::White
+                 ? generateMovesForSide<Side::White>(stack, boardControl, type)
+                 : generateMovesForSide<Side::Black>(stack, boardControl, type);
+}
+
+StackVector<Move> GameState::generateMovesInCheckOfType(
+        StackOfVectors<Move>& stack,
+        const BoardControl& boardControl,
+        const MoveGenerationType type) const {
+    return sideToMove_ == Side::White
+                 ? generateMovesInCheckForSide<Side::White>(stack, boardControl, type)
+                 : generateMovesInCheckForSide<Side::Black>(stack, boardControl, type);
+}
+
+StackVector<Move> GameState::generateTacticalMoves(
+        StackOfVectors<Move>& stack, const BoardControl& boardControl) const {
+    return generateMovesOfType(stack, boardControl, MoveGenerationType::Tactical);
+}
+
+StackVector<Move> GameState::generateQuietMoves(
+        StackOfVectors<Move>& stack, const BoardControl& boardControl) const {
+    return generateMovesOfType(stack, boardControl, MoveGenerationType::Quiet);
+}
+
+template <Side SideToMove>
+StackVector<Move> GameState::generateMovesForSide(
+        StackOfVectors<Move>& stack,
+        const BoardControl& boardControl,
+        const MoveGenerationType type) const {
+    MY_ASSERT(SideToMove == sideToMove_);
 
     if (isInCheck(boardControl)) {
-        return generateMovesInCheck(stack, boardControl, capturesOnly);
+        return generateMovesInCheckForSide<SideToMove>(stack, boardControl, type);
     }
 
     StackVector<Move> moves = stack.makeStackVector();
 
     const BoardPosition ownKingPosition =
-            getFirstSetPosition(getPieceBitBoard(sideToMove_, Piece::King));
+            getFirstSetPosition(getPieceBitBoard(SideToMove, Piece::King));
 
-    const BitBoard pinBitBoard = getPinBitBoard(sideToMove_, ownKingPosition);
+    const BitBoard pinBitBoard = getPinBitBoard(SideToMove, ownKingPosition);
 
     const auto getPiecePinBitBoard = [&](BoardPosition position) {
         if (!(pinBitBoard & position)) {
@@ -252,25 +337,24 @@ StackVector<Move> GameState::generateMoves(
             enPassantCheck ? BoardPosition::Invalid : enPassantTarget_;
 
     // Generate moves for pawns
-    generatePawnMoves(
-            getPieceBitBoard(sideToMove_, Piece::Pawn),
-            sideToMove_,
+    generatePawnMoves<SideToMove>(
+            getPieceBitBoard(SideToMove, Piece::Pawn),
             occupancy_,
             enPassantTarget,
             pinBitBoard,
             ownKingPosition,
             moves,
-            capturesOnly);
+            type);
 
     const BitBoard anyOccupancy = getAnyOccupancy();
 
-    int pieceControlIdx = boardControl.getPieceControlStartIdx(sideToMove_);
+    int pieceControlIdx = boardControl.getPieceControlStartIdx(SideToMove);
 
     // Generate moves for normal pieces (non-pawns excl. king)
     for (int pieceIdx = 1; pieceIdx < kNumPieceTypes - 1; ++pieceIdx) {
         const Piece piece = (Piece)pieceIdx;
 
-        BitBoard pieceBitBoard = getPieceBitBoard(sideToMove_, piece);
+        BitBoard pieceBitBoard = getPieceBitBoard(SideToMove, piece);
 
         while (pieceBitBoard != BitBoard::Empty) {
             const BoardPosition piecePosition = popFirstSetPosition(pieceBitBoard);
@@ -282,19 +366,19 @@ StackVector<Move> GameState::generateMoves(
                     piece,
                     piecePosition,
                     controlledSquares & piecePinBitBoard,
-                    getOwnOccupancy(),
-                    getEnemyOccupancy(),
+                    getSideOccupancy(SideToMove),
+                    getSideOccupancy(nextSide(SideToMove)),
                     moves,
-                    capturesOnly);
+                    type);
         }
     }
 
     // Generate king moves
-    const BitBoard& enemyControl = boardControl.getEnemyControl(sideToMove_);
+    const BitBoard& enemyControl = boardControl.getEnemyControl(SideToMove);
 
     // Normal king moves
     const BoardPosition kingPosition =
-            getFirstSetPosition(getPieceBitBoard(sideToMove_, Piece::King));
+            getFirstSetPosition(getPieceBitBoard(SideToMove, Piece::King));
     // King can't walk into check
     MY_ASSERT((std::size_t)pieceControlIdx < boardControl.pieceControl.size());
     const BitBoard kingControlledSquares =
@@ -303,17 +387,16 @@ StackVector<Move> GameState::generateMoves(
             Piece::King,
             kingPosition,
             kingControlledSquares,
-            getOwnOccupancy(),
-            getEnemyOccupancy(),
+            getSideOccupancy(SideToMove),
+            getSideOccupancy(nextSide(SideToMove)),
             moves,
-            capturesOnly);
+            type);
 
-    if (!capturesOnly) {
+    if (generatesNonCaptures(type)) {
         // Castling moves
-        generateCastlingMoves(
-                sideToMove_,
-                canCastleKingSide(sideToMove_),
-                canCastleQueenSide(sideToMove_),
+        generateCastlingMoves<SideToMove>(
+                canCastleKingSide(SideToMove),
+                canCastleQueenSide(SideToMove),
                 anyOccupancy,
                 enemyControl,
                 moves);
@@ -323,12 +406,17 @@ StackVector<Move> GameState::generateMoves(
     return moves;
 }
 
-StackVector<Move> GameState::generateMovesInCheck(
-        StackOfVectors<Move>& stack, const BoardControl& boardControl, bool capturesOnly) const {
+template <Side SideToMove>
+StackVector<Move> GameState::generateMovesInCheckForSide(
+        StackOfVectors<Move>& stack,
+        const BoardControl& boardControl,
+        const MoveGenerationType type) const {
+    MY_ASSERT(SideToMove == sideToMove_);
+
     StackVector<Move> moves = stack.makeStackVector();
 
     const BoardPosition kingPosition =
-            getFirstSetPosition(getPieceBitBoard(sideToMove_, Piece::King));
+            getFirstSetPosition(getPieceBitBoard(SideToMove, Piece::King));
 
     const BitBoard anyPieceNoKing = getAnyOccupancy() & ~kingPosition;
 
@@ -355,16 +443,16 @@ StackVector<Move> GameState::generateMovesInCheck(
 
     BitBoard kingControlledSquares = getKingControlledSquares(kingPosition);
     // King can't walk into check
-    kingControlledSquares = kingControlledSquares & ~boardControl.getEnemyControl(sideToMove_);
+    kingControlledSquares = kingControlledSquares & ~boardControl.getEnemyControl(SideToMove);
     kingControlledSquares = kingControlledSquares & ~kingAttackBitBoard;
     generateSinglePieceMovesFromControl(
             Piece::King,
             kingPosition,
             kingControlledSquares,
-            getOwnOccupancy(),
-            getEnemyOccupancy(),
+            getSideOccupancy(SideToMove),
+            getSideOccupancy(nextSide(SideToMove)),
             moves,
-            capturesOnly);
+            type);
 
     if (doubleCheck) {
         // Double check: only the king can move
@@ -393,20 +481,20 @@ StackVector<Move> GameState::generateMovesInCheck(
 
         const BitBoard kingPawnBitBoard = BitBoard::Empty | kingPosition;
 
-        const BitBoard kingPawnAttacks = getPawnControlledSquares(kingPawnBitBoard, sideToMove_);
+        const BitBoard kingPawnAttacks = getPawnControlledSquares(kingPawnBitBoard, SideToMove);
         const BitBoard checkingPawnBitBoard =
-                kingPawnAttacks & getPieceBitBoard(nextSide(sideToMove_), Piece::Pawn);
+                kingPawnAttacks & getPieceBitBoard(nextSide(SideToMove), Piece::Pawn);
 
         checkingPieceId.position = getFirstSetPosition(checkingPawnBitBoard);
     }
     blockOrCaptureBitBoard |= checkingPieceId.position;
 
-    const BitBoard pinBitBoard = getPinBitBoard(sideToMove_, kingPosition);
+    const BitBoard pinBitBoard = getPinBitBoard(SideToMove, kingPosition);
 
     bool canTakeCheckingPieceEnPassant = false;
     if (enPassantTarget_ != BoardPosition::Invalid) {
         const BoardPosition enPassantPiecePosition =
-                getEnPassantPiecePosition(enPassantTarget_, sideToMove_);
+                getEnPassantPiecePosition(enPassantTarget_, SideToMove);
 
         canTakeCheckingPieceEnPassant = enPassantPiecePosition == checkingPieceId.position;
         MY_ASSERT(IMPLIES(canTakeCheckingPieceEnPassant, checkingPieceId.piece == Piece::Pawn));
@@ -419,25 +507,24 @@ StackVector<Move> GameState::generateMovesInCheck(
     }
 
     // Generate pawn moves that either capture the checking piece or block
-    const BitBoard nonPinnedPawns = getPieceBitBoard(sideToMove_, Piece::Pawn) & ~pinBitBoard;
-    generatePawnMoves(
+    const BitBoard nonPinnedPawns = getPieceBitBoard(SideToMove, Piece::Pawn) & ~pinBitBoard;
+    generatePawnMoves<SideToMove>(
             nonPinnedPawns,
-            sideToMove_,
             occupancy_,
             enPassantTarget,
             /*pinBitBoard*/ BitBoard::Empty,
             kingPosition,
             moves,
-            capturesOnly,
+            type,
             pawnBlockOrCaptureBitBoard);
 
-    int pieceControlIdx = boardControl.getPieceControlStartIdx(sideToMove_);
+    int pieceControlIdx = boardControl.getPieceControlStartIdx(SideToMove);
 
     // Generate moves for normal pieces (non-pawns excl. king)
     for (int pieceIdx = 1; pieceIdx < kNumPieceTypes - 1; ++pieceIdx) {
         const Piece piece = (Piece)pieceIdx;
 
-        BitBoard pieceBitBoard = getPieceBitBoard(sideToMove_, piece);
+        BitBoard pieceBitBoard = getPieceBitBoard(SideToMove, piece);
 
         while (pieceBitBoard != BitBoard::Empty) {
             const BoardPosition piecePosition = popFirstSetPosition(pieceBitBoard);
@@ -457,10 +544,10 @@ StackVector<Move> GameState::generateMovesInCheck(
                     piece,
                     piecePosition,
                     controlledSquares & blockOrCaptureBitBoard,
-                    getOwnOccupancy(),
-                    getEnemyOccupancy(),
+                    getSideOccupancy(SideToMove),
+                    getSideOccupancy(nextSide(SideToMove)),
                     moves,
-                    capturesOnly);
+                    type);
         }
     }
 
@@ -475,10 +562,12 @@ GameState::UnmakeMoveInfo GameState::makeMove(const Move& move) {
             .plySinceCaptureOrPawn         = plySinceCaptureOrPawn_,
             .lastReversiblePositionHashIdx = lastReversiblePositionHashIdx_};
 
-    if (isCastle(move)) {
-        makeCastleMove(move);
-    } else {
-        unmakeInfo.capturedPiece = makeSinglePieceMove(move);
+    unmakeInfo.capturedPiece = sideToMove_ == Side::White ? makeMoveOnBoard<Side::White>(move)
+                                                          : makeMoveOnBoard<Side::Black>(move);
+
+    if (nnueNetwork_) {
+        updateNnueAccumulator</*Reverse*/ false>(
+                move, nextSide(sideToMove_), unmakeInfo.capturedPiece);
     }
 
     ++halfMoveClock_;
@@ -540,14 +629,18 @@ void GameState::unmakeMove(const Move& move, const UnmakeMoveInfo& unmakeMoveInf
     lastReversiblePositionHashIdx_ = unmakeMoveInfo.lastReversiblePositionHashIdx;
     previousHashes_.pop_back();
 
-    if (isCastle(move)) {
-        makeCastleMove(move, /*reverse*/ true);
+    if (sideToMove_ == Side::White) {
+        unmakeMoveOnBoard<Side::White>(move, unmakeMoveInfo);
     } else {
-        unmakeSinglePieceMove(move, unmakeMoveInfo);
+        unmakeMoveOnBoard<Side::Black>(move, unmakeMoveInfo);
     }
 
     boardHash_ = previousHashes_.back();
 
+    if (nnueNetwork_) {
+        updateNnueAccumulator</*Reverse*/ true>(move, sideToMove_, unmakeMoveInfo.capturedPiece);
+    }
+
     pinBitBoards_[0].reset();
     pinBitBoards_[1].reset();
 }
@@ -599,16 +692,124 @@ void GameState::removePiece(const BoardPosition position) {
     if (piece == Piece::Pawn || piece == Piece::King) {
         updateHashForPiecePosition(coloredPiece, position, pawnKingHash_);
     }
+
+    materialKey_.remove(pieceSide, piece, position);
+
+    if (nnueNetwork_) {
+        for (const Side perspective : {Side::White, Side::Black}) {
+            NnueFeatureChanges changes{};
+            changes.remove(getNnueFeatureIndex(
+                    perspective,
+                    nnueAccumulator_.kingBuckets[(int)perspective],
+                    pieceSide,
+                    piece,
+                    position));
+            nnueNetwork_->updateAccumulator(nnueAccumulator_.values[(int)perspective], changes);
+        }
+    }
 }
 
+void GameState::setNnueNetwork(const NnueNetwork* network) {
+    nnueNetwork_     = network;
+    nnueAccumulator_ = {};
+
+    if (nnueNetwork_) {
+        nnueNetwork_->refreshAccumulator(nnueAccumulator_, *this);
+    }
+}
+
+template <bool Reverse>
+FORCE_INLINE void GameState::updateNnueAccumulator(
+        const Move& move, const Side side, const Piece capturedPiece) {
+    const Side enemySide = nextSide(side);
+
+    for (const Side perspective : {Side::White, Side::Black}) {
+        int& kingBucket = nnueAccumulator_.kingBuckets[(int)perspective];
+
+        if (move.pieceToMove == Piece::King && side == perspective) {
+            const BoardPosition kingPosition = Reverse ? move.from : move.to;
+            if (getNnueKingBucket(perspective, kingPosition) != kingBucket) {
+                // All features of this perspective changed; recompute from scratch.
+                nnueNetwork_->refreshAccumulator(nnueAccumulator_, perspective, *this);
+                continue;
+            }
+        }
+
+        const auto feature = [&](const Side pieceSide, const Piece piece, const BoardPosition pos) {
+            return getNnueFeatureIndex(perspective, kingBucket, pieceSide, piece, pos);
+        };
+
+        NnueFeatureChanges changes{};
+
+        if (isCastle(move)) {
+            const auto [kingFromFile, kingRank] = fileRankFromPosition(move.from);
+            const int kingToFile                = fileFromPosition(move.to);
+            const int rookFromFile              = kingToFile == 2 ? /*a*/ 0 : /*h*/ 7;
+
+            const BoardPosition rookFromPosition = positionFromFileRank(rookFromFile, kingRank);
+            const BoardPosition rookToPosition =
+                    positionFromFileRank((kingFromFile + kingToFile) / 2, kingRank);
+
+            changes.remove(feature(side, Piece::King, move.from));
+            changes.remove(feature(side, Piece::Rook, rookFromPosition));
+            changes.add(feature(side, Piece::King, move.to));
+            changes.add(feature(side, Piece::Rook, rookToPosition));
+        } else {
+            const Piece promotionPiece = getPromotionPiece(move);
+            const Piece pieceAfterMove =
+                    promotionPiece != Piece::Pawn ? promotionPiece : move.pieceToMove;
+
+            changes.remove(feature(side, move.pieceToMove, move.from));
+            changes.add(feature(side, pieceAfterMove, move.to));
+
+            if (capturedPiece != Piece::Invalid) {
+                const BoardPosition capturePosition =
+                        isEnPassant(move) ? getEnPassantPiecePosition(move.to, side) : move.to;
+                changes.remove(feature(enemySide, capturedPiece, capturePosition));
+            }
+        }
+
+        if constexpr (Reverse) {
+            std::swap(changes.removed, changes.added);
+            std::swap(changes.numRemoved, changes.numAdded);
+        }
+
+        nnueNetwork_->updateAccumulator(nnueAccumulator_.values[(int)perspective], changes);
+    }
+}
+
+template <Side SideToMove>
+FORCE_INLINE Piece GameState::makeMoveOnBoard(const Move& move) {
+    MY_ASSERT(SideToMove == sideToMove_);
+
+    if (isCastle(move)) {
+        makeCastleMove<SideToMove>(move);
+        return Piece::Invalid;
+    }
+    return makeSinglePieceMove<SideToMove>(move);
+}
+
+template <Side SideToMove>
+FORCE_INLINE void GameState::unmakeMoveOnBoard(
+        const Move& move, const UnmakeMoveInfo& unmakeMoveInfo) {
+    MY_ASSERT(SideToMove == sideToMove_);
+
+    if (isCastle(move)) {
+        makeCastleMove<SideToMove>(move, /*reverse*/ true);
+    } else {
+        unmakeSinglePieceMove<SideToMove>(move, unmakeMoveInfo);
+    }
+}
+
+template <Side SideToMove>
 void GameState::makeCastleMove(const Move& move, const bool reverse) {
     const auto [kingFromFile, kingFromRank] = fileRankFromPosition(move.from);
 
     const auto [kingToFile, kingToRank] = fileRankFromPosition(move.to);
     const bool isQueenSide              = kingToFile == 2;  // c
 
-    MY_ASSERT(IMPLIES(isQueenSide, canCastleQueenSide(sideToMove_)));
-    MY_ASSERT(IMPLIES(!isQueenSide, canCastleKingSide(sideToMove_)));
+    MY_ASSERT(IMPLIES(isQueenSide, canCastleQueenSide(SideToMove)));
+    MY_ASSERT(IMPLIES(!isQueenSide, canCastleKingSide(SideToMove)));
 
     const int rookFromFile         = isQueenSide ? /*a*/ 0 : /*h*/ 7;
     BoardPosition rookFromPosition = positionFromFileRank(rookFromFile, kingFromRank);
@@ -623,7 +824,7 @@ void GameState::makeCastleMove(const Move& move, const bool reverse) {
         std::swap(kingFromPosition, kingToPosition);
     }
 
-    BitBoard& ownOccupancy = getOwnOccupancyMut();
+    BitBoard& ownOccupancy = getSideOccupancyMut(SideToMove);
 
     ownOccupancy &= ~kingFromPosition;
     ownOccupancy |= kingToPosition;
@@ -632,37 +833,37 @@ void GameState::makeCastleMove(const Move& move, const bool reverse) {
     ownOccupancy |= rookToPosition;
 
     // Update king
-    getPieceBitBoardMut(sideToMove_, Piece::King) = (BitBoard)(1ULL << (int)kingToPosition);
+    getPieceBitBoardMut(SideToMove, Piece::King) = (BitBoard)(1ULL << (int)kingToPosition);
 
     getPieceOnSquareMut(kingToPosition)   = getPieceOnSquare(kingFromPosition);
     getPieceOnSquareMut(kingFromPosition) = ColoredPiece::Invalid;
 
     // Update rook
-    BitBoard& rookBitBoard = getPieceBitBoardMut(sideToMove_, Piece::Rook);
+    BitBoard& rookBitBoard = getPieceBitBoardMut(SideToMove, Piece::Rook);
     rookBitBoard &= ~rookFromPosition;
     rookBitBoard |= rookToPosition;
 
     getPieceOnSquareMut(rookToPosition)   = getPieceOnSquare(rookFromPosition);
     getPieceOnSquareMut(rookFromPosition) = ColoredPiece::Invalid;
 
-    updateHashForPiecePosition(sideToMove_, Piece::King, kingFromPosition, pawnKingHash_);
-    updateHashForPiecePosition(sideToMove_, Piece::King, kingToPosition, pawnKingHash_);
+    updateHashForPiecePosition(SideToMove, Piece::King, kingFromPosition, pawnKingHash_);
+    updateHashForPiecePosition(SideToMove, Piece::King, kingToPosition, pawnKingHash_);
     updateHashForSideToMove(pawnKingHash_);
 
     if (!reverse) {
-        updateHashForPiecePosition(sideToMove_, Piece::King, kingFromPosition, boardHash_);
-        updateHashForPiecePosition(sideToMove_, Piece::King, kingToPosition, boardHash_);
+        updateHashForPiecePosition(SideToMove, Piece::King, kingFromPosition, boardHash_);
+        updateHashForPiecePosition(SideToMove, Piece::King, kingToPosition, boardHash_);
 
-        updateHashForPiecePosition(sideToMove_, Piece::Rook, rookFromPosition, boardHash_);
-        updateHashForPiecePosition(sideToMove_, Piece::Rook, rookToPosition, boardHash_);
+        updateHashForPiecePosition(SideToMove, Piece::Rook, rookFromPosition, boardHash_);
+        updateHashForPiecePosition(SideToMove, Piece::Rook, rookToPosition, boardHash_);
 
-        if (canCastleKingSide(sideToMove_)) {
-            setCanCastleKingSide(sideToMove_, false);
-            updateHashForKingSideCastlingRights(sideToMove_, boardHash_);
+        if (canCastleKingSide(SideToMove)) {
+            setCanCastleKingSide(SideToMove, false);
+            updateHashForKingSideCastlingRights(SideToMove, boardHash_);
         }
-        if (canCastleQueenSide(sideToMove_)) {
-            setCanCastleQueenSide(sideToMove_, false);
-            updateHashForQueenSideCastlingRights(sideToMove_, boardHash_);
+        if (canCastleQueenSide(SideToMove)) {
+            setCanCastleQueenSide(SideToMove, false);
+            updateHashForQueenSideCastlingRights(SideToMove, boardHash_);
         }
 
         if (enPassantTarget_ != BoardPosition::Invalid) {
@@ -670,13 +871,14 @@ void GameState::makeCastleMove(const Move& move, const bool reverse) {
             enPassantTarget_ = BoardPosition::Invalid;
         }
 
-        sideToMove_ = nextSide(sideToMove_);
+        sideToMove_ = nextSide(SideToMove);
         ++plySinceCaptureOrPawn_;
 
         updateHashForSideToMove(boardHash_);
     }
 }
 
+template <Side SideToMove>
 Piece GameState::makeSinglePieceMove(const Move& move) {
     Piece capturedPiece               = Piece::Invalid;
     BoardPosition captureTargetSquare = move.to;
@@ -697,49 +899,51 @@ Piece GameState::makeSinglePieceMove(const Move& move) {
 
     MY_ASSERT(move.from != BoardPosition::Invalid && move.to != BoardPosition::Invalid);
 
-    BitBoard& ownOccupancy = getOwnOccupancyMut();
+    BitBoard& ownOccupancy = getSideOccupancyMut(SideToMove);
     ownOccupancy &= ~move.from;
     ownOccupancy |= move.to;
 
     if (isCapture(move)) {
-        getEnemyOccupancyMut() &= ~captureTargetSquare;
+        getSideOccupancyMut(nextSide(SideToMove)) &= ~captureTargetSquare;
 
         capturedPiece = getPiece(getPieceOnSquare(captureTargetSquare));
         MY_ASSERT(capturedPiece != Piece::Invalid);
 
-        getPieceBitBoardMut(nextSide(sideToMove_), capturedPiece) &= ~captureTargetSquare;
+        getPieceBitBoardMut(nextSide(SideToMove), capturedPiece) &= ~captureTargetSquare;
 
         if (capturedPiece == Piece::Rook) {
-            updateRookCastlingRights(captureTargetSquare, nextSide(sideToMove_));
+            updateRookCastlingRights(captureTargetSquare, nextSide(SideToMove));
         }
 
+        materialKey_.remove(nextSide(SideToMove), capturedPiece, captureTargetSquare);
+
         updateHashForPiecePosition(
-                nextSide(sideToMove_), capturedPiece, captureTargetSquare, boardHash_);
+                nextSide(SideToMove), capturedPiece, captureTargetSquare, boardHash_);
 
         if (capturedPiece == Piece::Pawn) {
             updateHashForPiecePosition(
-                    nextSide(sideToMove_), capturedPiece, captureTargetSquare, pawnKingHash_);
+                    nextSide(SideToMove), capturedPiece, captureTargetSquare, pawnKingHash_);
         }
     }
 
-    BitBoard& pieceBitBoard = getPieceBitBoardMut(sideToMove_, move.pieceToMove);
+    BitBoard& pieceBitBoard = getPieceBitBoardMut(SideToMove, move.pieceToMove);
     pieceBitBoard &= ~move.from;
     pieceBitBoard |= move.to;
 
     MY_ASSERT(getPiece(getPieceOnSquare(move.from)) == move.pieceToMove);
-    MY_ASSERT(getSide(getPieceOnSquare(move.from)) == sideToMove_);
+    MY_ASSERT(getSide(getPieceOnSquare(move.from)) == SideToMove);
 
     MY_ASSERT(IMPLIES(
             isCapture(move), getPieceOnSquare(captureTargetSquare) != ColoredPiece::Invalid));
     MY_ASSERT(
             IMPLIES(isCapture(move),
-                    getSide(getPieceOnSquare(captureTargetSquare)) == nextSide(sideToMove_)));
+                    getSide(getPieceOnSquare(captureTargetSquare)) == nextSide(SideToMove)));
 
     getPieceOnSquareMut(move.to)   = getPieceOnSquare(move.from);
     getPieceOnSquareMut(move.from) = ColoredPiece::Invalid;
 
-    updateHashForPiecePosition(sideToMove_, move.pieceToMove, move.from, boardHash_);
-    updateHashForPiecePosition(sideToMove_, move.pieceToMove, move.to, boardHash_);
+    updateHashForPiecePosition(SideToMove, move.pieceToMove, move.from, boardHash_);
+    updateHashForPiecePosition(SideToMove, move.pieceToMove, move.to, boardHash_);
 
     // pawnKingHash_ updated in handlePawnMove or handleNormalKingMove
 
@@ -748,11 +952,11 @@ Piece GameState::makeSinglePieceMove(const Move& move) {
     }
 
     if (move.pieceToMove == Piece::Pawn) {
-        handlePawnMove(move);
+        handlePawnMove<SideToMove>(move);
     } else if (move.pieceToMove == Piece::King) {
-        handleNormalKingMove(move);
+        handleNormalKingMove<SideToMove>(move);
     } else if (move.pieceToMove == Piece::Rook) {
-        updateRookCastlingRights(move.from, sideToMove_);
+        updateRookCastlingRights(move.from, SideToMove);
     }
 
     if (isCapture(move) || move.pieceToMove == Piece::Pawn) {
@@ -761,7 +965,7 @@ Piece GameState::makeSinglePieceMove(const Move& move) {
         ++plySinceCaptureOrPawn_;
     }
 
-    sideToMove_ = nextSide(sideToMove_);
+    sideToMove_ = nextSide(SideToMove);
 
     updateHashForSideToMove(boardHash_);
     updateHashForSideToMove(pawnKingHash_);
@@ -769,27 +973,32 @@ Piece GameState::makeSinglePieceMove(const Move& move) {
     return capturedPiece;
 }
 
-void GameState::unmakeSinglePieceMove(const Move& move, const UnmakeMoveInfo& unmakeMoveInfo) {
-    BitBoard& ownOccupancy = getOwnOccupancyMut();
+template <Side SideToMove>
+void GameState::unmakeSinglePieceMove(
+        const Move& move, const UnmakeMoveInfo& unmakeMoveInfo) {
+    BitBoard& ownOccupancy = getSideOccupancyMut(SideToMove);
     ownOccupancy |= move.from;
     ownOccupancy &= ~move.to;
 
-    BitBoard& pieceBitBoard = getPieceBitBoardMut(sideToMove_, move.pieceToMove);
+    BitBoard& pieceBitBoard = getPieceBitBoardMut(SideToMove, move.pieceToMove);
     pieceBitBoard &= ~move.to;
     pieceBitBoard |= move.from;
 
     // Can't use getPieceOnSquare(move.to) here because that fails when undoing a promotion.
-    getPieceOnSquareMut(move.from) = getColoredPiece(move.pieceToMove, sideToMove_);
+    getPieceOnSquareMut(move.from) = getColoredPiece(move.pieceToMove, SideToMove);
 
     const Piece promotionPiece = getPromotionPiece(move);
     if (promotionPiece != Piece::Pawn) {
-        BitBoard& promotionBitBoard = getPieceBitBoardMut(sideToMove_, promotionPiece);
+        BitBoard& promotionBitBoard = getPieceBitBoardMut(SideToMove, promotionPiece);
         promotionBitBoard &= ~move.to;
 
-        updateHashForPiecePosition(sideToMove_, Piece::Pawn, move.from, pawnKingHash_);
+        updateHashForPiecePosition(SideToMove, Piece::Pawn, move.from, pawnKingHash_);
+
+        materialKey_.remove(SideToMove, promotionPiece, move.to);
+        materialKey_.add(SideToMove, Piece::Pawn, move.from);
     } else if (move.pieceToMove == Piece::Pawn || move.pieceToMove == Piece::King) {
-        updateHashForPiecePosition(sideToMove_, move.pieceToMove, move.to, pawnKingHash_);
-        updateHashForPiecePosition(sideToMove_, move.pieceToMove, move.from, pawnKingHash_);
+        updateHashForPiecePosition(SideToMove, move.pieceToMove, move.to, pawnKingHash_);
+        updateHashForPiecePosition(SideToMove, move.pieceToMove, move.from, pawnKingHash_);
     }
 
     if (isCapture(move)) {
@@ -804,20 +1013,22 @@ void GameState::unmakeSinglePieceMove(const Move& move, const UnmakeMoveInfo& un
         }
 
         BitBoard& capturedPieceBitBoard =
-                getPieceBitBoardMut(nextSide(sideToMove_), unmakeMoveInfo.capturedPiece);
+                getPieceBitBoardMut(nextSide(SideToMove), unmakeMoveInfo.capturedPiece);
         capturedPieceBitBoard |= captureTarget;
-        getEnemyOccupancyMut() |= captureTarget;
+        getSideOccupancyMut(nextSide(SideToMove)) |= captureTarget;
 
         getPieceOnSquareMut(captureTarget) =
-                getColoredPiece(unmakeMoveInfo.capturedPiece, nextSide(sideToMove_));
+                getColoredPiece(unmakeMoveInfo.capturedPiece, nextSide(SideToMove));
         if (isEnPassant(move)) {
             getPieceOnSquareMut(move.to) = ColoredPiece::Invalid;
         }
 
         if (unmakeMoveInfo.capturedPiece == Piece::Pawn) {
             updateHashForPiecePosition(
-                    nextSide(sideToMove_), Piece::Pawn, captureTarget, pawnKingHash_);
+                    nextSide(SideToMove), Piece::Pawn, captureTarget, pawnKingHash_);
         }
+
+        materialKey_.add(nextSide(SideToMove), unmakeMoveInfo.capturedPiece, captureTarget);
     } else {
         getPieceOnSquareMut(move.to) = ColoredPiece::Invalid;
     }
@@ -825,24 +1036,28 @@ void GameState::unmakeSinglePieceMove(const Move& move, const UnmakeMoveInfo& un
     updateHashForSideToMove(pawnKingHash_);
 }
 
+template <Side SideToMove>
 void GameState::handlePawnMove(const Move& move) {
     const Piece promotionPiece = getPromotionPiece(move);
     if (promotionPiece != Piece::Pawn) {
-        BitBoard& pawnBitBoard           = getPieceBitBoardMut(sideToMove_, Piece::Pawn);
-        BitBoard& promotionPieceBitBoard = getPieceBitBoardMut(sideToMove_, promotionPiece);
+        BitBoard& pawnBitBoard           = getPieceBitBoardMut(SideToMove, Piece::Pawn);
+        BitBoard& promotionPieceBitBoard = getPieceBitBoardMut(SideToMove, promotionPiece);
 
         pawnBitBoard &= ~move.to;
         promotionPieceBitBoard |= move.to;
 
-        getPieceOnSquareMut(move.to) = getColoredPiece(promotionPiece, sideToMove_);
+        getPieceOnSquareMut(move.to) = getColoredPiece(promotionPiece, SideToMove);
+
+        updateHashForPiecePosition(SideToMove, Piece::Pawn, move.to, boardHash_);
+        updateHashForPiecePosition(SideToMove, promotionPiece, move.to, boardHash_);
 
-        updateHashForPiecePosition(sideToMove_, Piece::Pawn, move.to, boardHash_);
-        updateHashForPiecePosition(sideToMove_, promotionPiece, move.to, boardHash_);
+        updateHashForPiecePosition(SideToMove, Piece::Pawn, move.from, pawnKingHash_);
 
-        updateHashForPiecePosition(sideToMove_, Piece::Pawn, move.from, pawnKingHash_);
+        materialKey_.remove(SideToMove, Piece::Pawn, move.to);
+        materialKey_.add(SideToMove, promotionPiece, move.to);
     } else {
-        updateHashForPiecePosition(sideToMove_, Piece::Pawn, move.from, pawnKingHash_);
-        updateHashForPiecePosition(sideToMove_, Piece::Pawn, move.to, pawnKingHash_);
+        updateHashForPiecePosition(SideToMove, Piece::Pawn, move.from, pawnKingHash_);
+        updateHashForPiecePosition(SideToMove, Piece::Pawn, move.to, pawnKingHash_);
     }
 
     const auto [fromFile, fromRank] = fileRankFromPosition(move.from);
@@ -854,7 +1069,7 @@ void GameState::handlePawnMove(const Move& move) {
         const std::uint64_t neighborMask =
                 (toMask & kNotWestFileMask) >> 1 | (toMask & kNotEastFileMask) << 1;
 
-        const BitBoard& opponentPawns = getPieceBitBoard(nextSide(sideToMove_), Piece::Pawn);
+        const BitBoard& opponentPawns = getPieceBitBoard(nextSide(SideToMove), Piece::Pawn);
 
         const bool pawnCanCaptureEnPassant =
                 (opponentPawns & (BitBoard)neighborMask) != BitBoard::Empty;
@@ -867,19 +1082,20 @@ void GameState::handlePawnMove(const Move& move) {
     }
 }
 
+template <Side SideToMove>
 void GameState::handleNormalKingMove(const Move& move) {
-    if (canCastleKingSide(sideToMove_)) {
-        setCanCastleKingSide(sideToMove_, false);
-        updateHashForKingSideCastlingRights(sideToMove_, boardHash_);
+    if (canCastleKingSide(SideToMove)) {
+        setCanCastleKingSide(SideToMove, false);
+        updateHashForKingSideCastlingRights(SideToMove, boardHash_);
     }
 
-    if (canCastleQueenSide(sideToMove_)) {
-        setCanCastleQueenSide(sideToMove_, false);
-        updateHashForQueenSideCastlingRights(sideToMove_, boardHash_);
+    if (canCastleQueenSide(SideToMove)) {
+        setCanCastleQueenSide(SideToMove, false);
+        updateHashForQueenSideCastlingRights(SideToMove, boardHash_);
     }
 
-    updateHashForPiecePosition(sideToMove_, Piece::King, move.from, pawnKingHash_);
-    updateHashForPiecePosition(sideToMove_, Piece::King, move.to, pawnKingHash_);
+    updateHashForPiecePosition(SideToMove, Piece::King, move.from, pawnKingHash_);
+    updateHashForPiecePosition(SideToMove, Piece::King, move.to, pawnKingHash_);
 }
 
 void GameState::updateRookCastlingRights(const BoardPosition rookPosition, const Side rookSide) {
@@ -1204,6 +1420,75 @@ bool GameState::givesCheck(
     return false;
 }
 
+bool GameState::isPseudoLegal(const Move& move) const {
+    MY_ASSERT(!isCapture(move) && !isPromotion(move));
+
+    if (getPieceOnSquare(move.from) != getColoredPiece(move.pieceToMove, sideToMove_)) {
+        return false;
+    }
+    if (getPieceOnSquare(move.to) != ColoredPiece::Invalid) {
+        return false;
+    }
+
+    const BitBoard anyPiece = getAnyOccupancy();
+
+    if (move.pieceToMove == Piece::Pawn) {
+        const int forward  = sideToMove_ == Side::White ? 8 : -8;
+        const int fromIdx  = (int)move.from;
+        const int toIdx    = (int)move.to;
+        const int homeRank = sideToMove_ == Side::White ? 1 : 6;
+
+        if (toIdx == fromIdx + forward) {
+            return true;
+        }
+
+        return toIdx == fromIdx + 2 * forward && rankFromPosition(move.from) == homeRank
+            && !(anyPiece & (BoardPosition)(fromIdx + forward));
+    }
+
+    if (isCastle(move)) {
+        // The castling right implies that the king and rook are on their starting squares.
+        const int rank        = rankFromPosition(move.from);
+        const bool isKingSide = fileFromPosition(move.to) > fileFromPosition(move.from);
+        if (isKingSide) {
+            return canCastleKingSide(sideToMove_)
+                && (anyPiece & (BitBoard)(0x60ULL << (rank * 8))) == BitBoard::Empty;
+        }
+        return canCastleQueenSide(sideToMove_)
+            && (anyPiece & (BitBoard)(0xeULL << (rank * 8))) == BitBoard::Empty;
+    }
+
+    return getPieceControlledSquares(move.pieceToMove, move.from, anyPiece) & move.to;
+}
+
+bool GameState::isLegal(const Move& move, const BoardControl& boardControl) const {
+    MY_ASSERT(!isInCheck(boardControl));
+
+    const BitBoard& enemyControl = boardControl.getEnemyControl(sideToMove_);
+
+    if (isCastle(move)) {
+        // We're not in check, so only the squares the king passes through and lands on matter.
+        const int rank        = rankFromPosition(move.from);
+        const bool isKingSide = fileFromPosition(move.to) > fileFromPosition(move.from);
+        const BitBoard kingPath =
+                (BitBoard)((isKingSide ? 0x60ULL : 0xcULL) << (rank * 8));
+        return (kingPath & enemyControl) == BitBoard::Empty;
+    }
+
+    if (move.pieceToMove == Piece::King) {
+        return !(enemyControl & move.to);
+    }
+
+    // Pinned pieces can only move along the pin.
+    const BoardPosition kingPosition =
+            getFirstSetPosition(getPieceBitBoard(sideToMove_, Piece::King));
+    if (!(getPinBitBoard(sideToMove_, kingPosition) & move.from)) {
+        return true;
+    }
+
+    return getKingRayBitBoard(move.from, kingPosition) & move.to;
+}
+
 GameState::CheckInformation GameState::getCheckInformation() const {
     const Side enemySide    = nextSide(sideToMove_);
     const BitBoard anyPiece = getAnyOccupancy();
@@ -4,8 +4,10 @@
 #include "BoardConstants.h"
 #include "BoardHash.h"
 #include "BoardPosition.h"
+#include "MaterialKey.h"
 #include "Move.h"
 #include "MyAssert.h"
+#include "NnueAccumulator.h"
 #include "Piece.h"
 #include "Side.h"
 #include "StackOfVectors.h"
@@ -22,6 +24,18 @@
     return "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
 }
 
+// Which subset of the legal moves to generate.
+enum class MoveGenerationType {
+    All,
+    // Captures, including capturing promotions and en passant.
+    CapturesOnly,
+    // Captures and non-capturing queen promotions; i.e., the moves for which isCaptureOrQueenPromo
+    // is true.
+    Tactical,
+    // All moves that are not tactical.
+    Quiet,
+};
+
 using PieceBitBoards = std::array<std::array<BitBoard, kNumPieceTypes>, kNumSides>;
 
 struct BoardControl {
@@ -85,6 +99,16 @@ class GameState {
             const std::array<BitBoard, kNumPieceTypes - 1>& directCheckBitBoards,
             const std::optional<BitBoard>& enemyPinBitBoard) const;
 
+    // Checks whether a quiet move (not a capture or promotion) that may have been generated for a
+    // different position, like a killer move, is pseudo-legal in this position. That is: the piece is
+    // on the origin square, it can reach the empty target square, and castling moves have the
+    // castling right and an empty path. This is much cheaper than generating all moves.
+    [[nodiscard]] bool isPseudoLegal(const Move& move) const;
+
+    // Checks whether a pseudo-legal move doesn't leave our king in check. Must only be called when
+    // not in check.
+    [[nodiscard]] bool isLegal(const Move& move, const BoardControl& boardControl) const;
+
     [[nodiscard]] StackVector<Move> generateMoves(
             StackOfVectors<Move>& stack, bool capturesOnly = false) const;
     [[nodiscard]] StackVector<Move> generateMoves(
@@ -96,6 +120,14 @@ class GameState {
             const BoardControl& boardControl,
             bool capturesOnly = false) const;
 
+    // Generate the tactical or quiet moves separately, so that quiet move generation can be
+    // skipped when a tactical move causes a cutoff. Together these produce the same moves as
+    // generateMoves.
+    [[nodiscard]] StackVector<Move> generateTacticalMoves(
+            StackOfVectors<Move>& stack, const BoardControl& boardControl) const;
+    [[nodiscard]] StackVector<Move> generateQuietMoves(
+            StackOfVectors<Move>& stack, const BoardControl& boardControl) const;
+
     UnmakeMoveInfo makeMove(const Move& move);
     UnmakeMoveInfo makeNullMove();
     void unmakeMove(const Move& move, const UnmakeMoveInfo& unmakeMoveInfo);
@@ -150,6 +182,8 @@ class GameState {
     [[nodiscard]] HashT getBoardHash() const { return boardHash_; }
     [[nodiscard]] HashT getPawnKingHash() const { return pawnKingHash_; }
 
+    [[nodiscard]] const MaterialKey& getMaterialKey() const { return materialKey_; }
+
     [[nodiscard]] BitBoard getAnyOccupancy() const { return occupancy_[0] | occupancy_[1]; }
 
     [[nodiscard]] int getNumPieces() const { return popCount(getAnyOccupancy()); }
@@ -174,6 +208,15 @@ class GameState {
 
     [[nodiscard]] DirectCheckBitBoards getDirectCheckBitBoards() const;
 
+    // Start incrementally maintaining the accumulator of network, or stop maintaining it if network
+    // is nullptr. The network must outlive this object (and its copies).
+    void setNnueNetwork(const NnueNetwork* network);
+
+    [[nodiscard]] const NnueNetwork* getNnueNetwork() const { return nnueNetwork_; }
+
+    // Only valid if an NNUE network is set.
+    [[nodiscard]] const NnueAccumulator& getNnueAccumulator() const { return nnueAccumulator_; }
+
   private:
     struct PieceIdentifier {
         Piece piece;
@@ -205,6 +248,29 @@ class GameState {
         return getSideOccupancyMut(nextSide(sideToMove_));
     }
 
+    [[nodiscard]] StackVector<Move> generateMovesOfType(
+            StackOfVectors<Move>& stack,
+            const BoardControl& boardControl,
+            MoveGenerationType type) const;
+    [[nodiscard]] StackVector<Move> generateMovesInCheckOfType(
+            StackOfVectors<Move>& stack,
+            const BoardControl& boardControl,
+            MoveGenerationType type) const;
+
+    // Move generation and make/unmake are specialized on the side to move, so that directions,
+    // ranks and masks that depend on it are compile-time constants. SideToMove must be equal to
+    // sideToMove_.
+    template <Side SideToMove>
+    [[nodiscard]] StackVector<Move> generateMovesForSide(
+            StackOfVectors<Move>& stack,
+            const BoardControl& boardControl,
+            MoveGenerationType type) const;
+    template <Side SideToMove>
+    [[nodiscard]] StackVector<Move> generateMovesInCheckForSide(
+            StackOfVectors<Move>& stack,
+            const BoardControl& boardControl,
+            MoveGenerationType type) const;
+
     [[nodiscard]] bool enPassantWillPutUsInCheck() const;
 
     [[nodiscard]] CheckInformation getCheckInformation() const;
@@ -213,14 +279,29 @@ class GameState {
     void setCanCastleQueenSide(Side side, bool canCastle);
     void setCanCastle(Side side, CastlingRights castlingSide, bool canCastle);
 
+    // Returns the captured piece, if any.
+    template <Side SideToMove>
+    [[nodiscard]] Piece makeMoveOnBoard(const Move& move);
+    template <Side SideToMove>
+    void unmakeMoveOnBoard(const Move& move, const UnmakeMoveInfo& unmakeMoveInfo);
+
+    template <Side SideToMove>
     void makeCastleMove(const Move& move, bool reverse = false);
+    template <Side SideToMove>
     [[nodiscard]] Piece makeSinglePieceMove(const Move& move);
+    template <Side SideToMove>
     void handlePawnMove(const Move& move);
+    template <Side SideToMove>
     void handleNormalKingMove(const Move& move);
     void updateRookCastlingRights(BoardPosition rookPosition, Side rookSide);
 
+    template <Side SideToMove>
     void unmakeSinglePieceMove(const Move& move, const UnmakeMoveInfo& unmakeMoveInfo);
 
+    // Update the NNUE accumulator for a move by side that was just made (or unmade if Reverse).
+    template <bool Reverse>
+    void updateNnueAccumulator(const Move& move, Side side, Piece capturedPiece);
+
     GameState() = default;
 
     Side sideToMove_ = Side::White;
@@ -242,6 +323,8 @@ class GameState {
     HashT boardHash_    = 0;
     HashT pawnKingHash_ = 0;
 
+    MaterialKey materialKey_ = {};
+
     std::vector<HashT> previousHashes_ = {};
 
     // Index of the hash of the first position after the last irreversible move (in
@@ -249,4 +332,7 @@ class GameState {
     int lastReversiblePositionHashIdx_ = 0;
 
     mutable std::array<std::optional<BitBoard>, kNumSides> pinBitBoards_{};
+
+    const NnueNetwork* nnueNetwork_  = nullptr;
+    NnueAccumulator nnueAccumulator_ = {};
 };
@@ -309,6 +309,24 @@ HashT computePawnKingHash(const GameState& gameState) {
     return hash;
 }
 
+MaterialKey computeMaterialKey(const GameState& gameState) {
+    MaterialKey materialKey{};
+
+    for (int sideIdx = 0; sideIdx < kNumSides; ++sideIdx) {
+        const Side side = (Side)sideIdx;
+        for (int pieceIdx = 0; pieceIdx < kNumPieceTypes - 1; ++pieceIdx) {
+            const Piece piece      = (Piece)pieceIdx;
+            BitBoard pieceBitBoard = gameState.getPieceBitBoard(side, piece);
+            while (pieceBitBoard != BitBoard::Empty) {
+                const BoardPosition position = popFirstSetPosition(pieceBitBoard);
+                materialKey.add(side, piece, position);
+            }
+        }
+    }
+
+    return materialKey;
+}
+
 }  // namespace
 
 GameState GameState::fromFen(std::string_view fenString) {
@@ -362,6 +380,7 @@ GameState GameState::fromFen(std::string_view fenString) {
 
     gameState.boardHash_    = computeBoardHash(gameState);
     gameState.pawnKingHash_ = computePawnKingHash(gameState);
+    gameState.materialKey_  = computeMaterialKey(gameState);
 
     gameState.previousHashes_.reserve(500);
     gameState.previousHashes_.push_back(gameState.boardHash_);
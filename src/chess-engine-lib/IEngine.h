@@ -28,6 +28,9 @@ class IEngine {
 
     virtual void setTTableSize(int requestedSizeInMb) = 0;
 
+    // Block until the engine is ready to search (e.g., the transposition table has been allocated).
+    virtual void waitUntilReady() = 0;
+
     [[nodiscard]] virtual EvalT evaluate(const GameState& gameState) const = 0;
 
   protected:
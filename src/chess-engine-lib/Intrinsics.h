@@ -3,6 +3,13 @@
 #include "Macros.h"
 
 #include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+#include <array>
 
 #include <cstdint>
 
@@ -14,6 +21,22 @@ FORCE_INLINE inline std::uint64_t pext(std::uint64_t src, std::uint64_t mask) {
     return _pext_u64(src, mask);
 }
 
+// Returns eax, ebx, ecx, edx for the given CPUID leaf.
+inline std::array<std::uint32_t, 4> cpuid(const std::uint32_t leaf) {
+#ifdef _MSC_VER
+    std::array<int, 4> registers{};
+    __cpuid(registers.data(), (int)leaf);
+    return {(std::uint32_t)registers[0],
+            (std::uint32_t)registers[1],
+            (std::uint32_t)registers[2],
+            (std::uint32_t)registers[3]};
+#else
+    std::array<std::uint32_t, 4> registers{};
+    __cpuid(leaf, registers[0], registers[1], registers[2], registers[3]);
+    return registers;
+#endif
+}
+
 template <typename T>
 FORCE_INLINE void prefetch(const T* ptr) {
     _mm_prefetch(reinterpret_cast<const char*>(ptr), _MM_HINT_T0);
@@ -0,0 +1,111 @@
+#include "LargePages.h"
+
+#include "Math.h"
+
+#include <bit>
+#include <new>
+
+#include <cstdlib>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+constexpr std::size_t kHugePageSize = 2 * 1024 * 1024;
+
+[[nodiscard]] std::size_t roundUp(const std::size_t size, const std::size_t multiple) {
+    return (size + multiple - 1) / multiple * multiple;
+}
+
+[[nodiscard]] void* allocateAligned(const std::size_t sizeInBytes, const std::size_t alignment) {
+#ifdef _MSC_VER
+    return _aligned_malloc(sizeInBytes, alignment);
+#else
+    // std::aligned_alloc requires the size to be a multiple of the alignment.
+    return std::aligned_alloc(alignment, roundUp(sizeInBytes, alignment));
+#endif
+}
+
+void freeAligned(void* const data) {
+#ifdef _MSC_VER
+    _aligned_free(data);
+#else
+    std::free(data);
+#endif
+}
+
+}  // namespace
+
+std::string_view pageTypeToString(const PageType pageType) {
+    switch (pageType) {
+        case PageType::Regular:
+            return "regular pages";
+        case PageType::TransparentHuge:
+            // madvise succeeding doesn't guarantee that the kernel actually backs the memory with
+            // huge pages.
+            return "requested transparent huge pages";
+        case PageType::ExplicitHuge:
+            return "explicit huge pages";
+    }
+    UNREACHABLE;
+}
+
+LargePageAllocation allocateLargePages(const std::size_t sizeInBytes, std::size_t alignment) {
+    MY_ASSERT(std::has_single_bit(alignment));
+    alignment = max(alignment, alignof(std::max_align_t));
+
+#ifdef __linux__
+    if (sizeInBytes >= kHugePageSize) {
+        const std::size_t roundedSize = roundUp(sizeInBytes, kHugePageSize);
+
+        // First try to get explicit huge pages. This only works if the system has reserved huge
+        // pages (e.g., through /proc/sys/vm/nr_hugepages).
+        void* const hugeTlbData = mmap(
+                nullptr,
+                roundedSize,
+                PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                -1,
+                0);
+        if (hugeTlbData != MAP_FAILED) {
+            return {.data        = hugeTlbData,
+                    .sizeInBytes = roundedSize,
+                    .pageType    = PageType::ExplicitHuge};
+        }
+
+        // Otherwise, align to the huge page size and ask for transparent huge pages.
+        void* const data = allocateAligned(roundedSize, max(alignment, kHugePageSize));
+        if (data == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        const bool requestedTransparentHugePages =
+                madvise(data, roundedSize, MADV_HUGEPAGE) == 0;
+
+        return {.data        = data,
+                .sizeInBytes = roundedSize,
+                .pageType    = requestedTransparentHugePages ? PageType::TransparentHuge
+                                                             : PageType::Regular};
+    }
+#endif
+
+    void* const data = allocateAligned(sizeInBytes, alignment);
+    if (data == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return {.data = data, .sizeInBytes = sizeInBytes, .pageType = PageType::Regular};
+}
+
+void freeLargePages(const LargePageAllocation& allocation) {
+#ifdef __linux__
+    if (allocation.pageType == PageType::ExplicitHuge) {
+        munmap(allocation.data, allocation.sizeInBytes);
+        return;
+    }
+#endif
+
+    freeAligned(allocation.data);
+}
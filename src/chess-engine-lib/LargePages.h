@@ -0,0 +1,114 @@
+#pragma once
+
+#include "MyAssert.h"
+#include "Numa.h"
+#include "ParallelFor.h"
+
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#include <cstddef>
+
+enum class PageType {
+    Regular,
+    // Transparent huge pages requested with madvise(MADV_HUGEPAGE). The kernel will back the memory
+    // with huge pages where possible.
+    TransparentHuge,
+    // Explicit huge pages from the kernel's huge page pool (MAP_HUGETLB).
+    ExplicitHuge,
+};
+
+[[nodiscard]] std::string_view pageTypeToString(PageType pageType);
+
+struct LargePageAllocation {
+    void* data              = nullptr;
+    std::size_t sizeInBytes = 0;
+    PageType pageType       = PageType::Regular;
+};
+
+// Allocate memory, preferably backed by huge pages. Falls back to regular pages if huge pages are
+// not available. Throws std::bad_alloc on failure.
+[[nodiscard]] LargePageAllocation allocateLargePages(std::size_t sizeInBytes, std::size_t alignment);
+
+void freeLargePages(const LargePageAllocation& allocation);
+
+// Owning array of value-initialized elements, allocated using allocateLargePages.
+// Meant for large tables with random access patterns, where huge pages reduce TLB misses.
+template <typename T>
+class LargePageArray {
+  public:
+    LargePageArray() = default;
+
+    // The elements are initialized using numThreads threads. Besides speeding up initialization of
+    // large arrays, this spreads the first touch of the memory over the threads.
+    // If interleaveOverNumaNodes is set, the pages are spread over all NUMA nodes instead of being
+    // placed on the node of the thread that first touches them.
+    explicit LargePageArray(
+            std::size_t size, int numThreads = 1, bool interleaveOverNumaNodes = false);
+
+    ~LargePageArray() { reset(); }
+
+    LargePageArray(const LargePageArray&)            = delete;
+    LargePageArray& operator=(const LargePageArray&) = delete;
+
+    LargePageArray(LargePageArray&& other) noexcept
+        : allocation_(std::exchange(other.allocation_, {})), size_(std::exchange(other.size_, 0)) {}
+
+    LargePageArray& operator=(LargePageArray&& other) noexcept {
+        if (this != &other) {
+            reset();
+            allocation_ = std::exchange(other.allocation_, {});
+            size_       = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] T* get() const { return static_cast<T*>(allocation_.data); }
+
+    [[nodiscard]] T& operator[](const std::size_t index) const { return get()[index]; }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+    [[nodiscard]] bool empty() const { return allocation_.data == nullptr; }
+
+    [[nodiscard]] PageType getPageType() const { return allocation_.pageType; }
+
+    void reset();
+
+  private:
+    LargePageAllocation allocation_ = {};
+    std::size_t size_               = 0;
+};
+
+template <typename T>
+LargePageArray<T>::LargePageArray(
+        const std::size_t size, const int numThreads, const bool interleaveOverNumaNodes) {
+    if (size == 0) {
+        return;
+    }
+
+    allocation_ = allocateLargePages(size * sizeof(T), alignof(T));
+    size_       = size;
+
+    if (interleaveOverNumaNodes) {
+        interleaveMemoryOverNumaNodes(allocation_.data, allocation_.sizeInBytes);
+    }
+
+    parallelForChunks(size_, numThreads, [this](const std::size_t begin, const std::size_t end) {
+        std::uninitialized_value_construct(get() + begin, get() + end);
+    });
+}
+
+template <typename T>
+void LargePageArray<T>::reset() {
+    if (empty()) {
+        return;
+    }
+
+    std::destroy_n(get(), size_);
+    freeLargePages(allocation_);
+
+    allocation_ = {};
+    size_       = 0;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "BoardPosition.h"
+#include "Macros.h"
+#include "MyAssert.h"
+#include "Piece.h"
+#include "Side.h"
+
+#include <cstdint>
+
+// The number of pieces of each type per side (excluding kings), packed into a single integer.
+// Bishops are counted separately per square color, so that opposite colored bishops can be detected
+// from the key alone.
+//
+// Each count takes 4 bits, which is enough for any position reachable from the starting position
+// (at most 10 pieces of a type). Because the packing is linear, adding or removing a piece is a
+// single addition or subtraction.
+class MaterialKey {
+  public:
+    static constexpr int kBitsPerCount  = 4;
+    static constexpr int kCountsPerSide = 6;
+    static constexpr int kNumBits       = 2 * kCountsPerSide * kBitsPerCount;
+
+    constexpr MaterialKey() = default;
+
+    // Only the lower kNumBits bits of value may be set.
+    [[nodiscard]] static constexpr MaterialKey fromValue(const std::uint64_t value) {
+        MY_ASSERT(value >> kNumBits == 0);
+        return MaterialKey(value);
+    }
+
+    FORCE_INLINE void add(const Side side, const Piece piece, const BoardPosition position) {
+        value_ += getIncrement(side, piece, position);
+    }
+
+    FORCE_INLINE void remove(const Side side, const Piece piece, const BoardPosition position) {
+        MY_ASSERT(getCount(side, piece) > 0);
+        value_ -= getIncrement(side, piece, position);
+    }
+
+    // Number of pieces of the given type; for bishops, of both square colors.
+    [[nodiscard]] FORCE_INLINE int getCount(const Side side, const Piece piece) const {
+        MY_ASSERT(piece != Piece::King);
+
+        if (piece == Piece::Bishop) {
+            return getBishopCount(side, 0) + getBishopCount(side, 1);
+        }
+        return getCountAt(getSlot(side, piece, /*squareColor*/ 0));
+    }
+
+    // Number of bishops on squares of the given color (see getSquareColor).
+    [[nodiscard]] FORCE_INLINE int getBishopCount(const Side side, const int squareColor) const {
+        return getCountAt(getSlot(side, Piece::Bishop, squareColor));
+    }
+
+    // True if the side has no pieces of the given type.
+    [[nodiscard]] FORCE_INLINE bool hasNone(const Side side, const Piece piece) const {
+        return (value_ & getMask(side, piece)) == 0;
+    }
+
+    [[nodiscard]] FORCE_INLINE std::uint64_t getValue() const { return value_; }
+
+    bool operator==(const MaterialKey& other) const = default;
+
+  private:
+    explicit constexpr MaterialKey(const std::uint64_t value) : value_(value) {}
+
+    // Slots per side: pawns, knights, dark squared bishops, light squared bishops, rooks, queens.
+    [[nodiscard]] FORCE_INLINE static int getSlot(
+            const Side side, const Piece piece, const int squareColor) {
+        MY_ASSERT(piece != Piece::King && piece != Piece::Invalid);
+
+        int slotInSide = (int)piece;
+        if (piece == Piece::Bishop) {
+            slotInSide += squareColor;
+        } else if (piece > Piece::Bishop) {
+            slotInSide += 1;
+        }
+        return (int)side * kCountsPerSide + slotInSide;
+    }
+
+    [[nodiscard]] FORCE_INLINE static std::uint64_t getIncrement(
+            const Side side, const Piece piece, const BoardPosition position) {
+        const int squareColor = piece == Piece::Bishop ? getSquareColor(position) : 0;
+        return std::uint64_t{1} << (getSlot(side, piece, squareColor) * kBitsPerCount);
+    }
+
+    [[nodiscard]] FORCE_INLINE static std::uint64_t getMask(const Side side, const Piece piece) {
+        constexpr std::uint64_t kCountMask = (1 << kBitsPerCount) - 1;
+
+        if (piece == Piece::Bishop) {
+            constexpr std::uint64_t kBishopsMask = kCountMask | (kCountMask << kBitsPerCount);
+            return kBishopsMask << (getSlot(side, piece, 0) * kBitsPerCount);
+        }
+        return kCountMask << (getSlot(side, piece, 0) * kBitsPerCount);
+    }
+
+    [[nodiscard]] FORCE_INLINE int getCountAt(const int slot) const {
+        return (int)(value_ >> (slot * kBitsPerCount)) & ((1 << kBitsPerCount) - 1);
+    }
+
+    std::uint64_t value_ = 0;
+};
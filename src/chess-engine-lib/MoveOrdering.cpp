@@ -5,16 +5,14 @@
 #include "MyAssert.h"
 #include "SEE.h"
 
+#include <algorithm>
 #include <print>
+#include <span>
 
 namespace {
 
-// Killer and counter bonuses can potentially both apply.
-// Make sure that the combined bonus is less than the capture and promotion bonuses.
-constexpr int kCaptureBonus     = 160'000;
-constexpr int kPromotionBonus   = 160'000;
-constexpr int kKillerMoveBonus  = 80'000;
-constexpr int kCounterMoveBonus = 40'000;
+constexpr int kCaptureBonus   = 160'000;
+constexpr int kPromotionBonus = 160'000;
 
 constexpr int kMaxHistory = 4096;
 
@@ -39,25 +37,10 @@ constexpr std::array<int, kNumPieceTypes> kEnterThreatPenalty = {
 namespace checks {
 constexpr int kMaxControlBonus = 16'000;
 
-constexpr int kMinKillerCounterMoveScore = kKillerMoveBonus + kCounterMoveBonus - kMaxHistory;
-constexpr int kMaxKillerCounterMoveScore = kKillerMoveBonus + kCounterMoveBonus + kMaxHistory;
-
-constexpr int kMinKillerMoveScore = kKillerMoveBonus - kMaxHistory;
-constexpr int kMaxKillerMoveScore = kKillerMoveBonus + kMaxHistory;
-
-constexpr int kMinCounterMoveScore = kCounterMoveBonus - kMaxHistory;
-constexpr int kMaxCounterMoveScore = kCounterMoveBonus + kMaxHistory;
-
 constexpr int kMaxRegularQuiet = kMaxHistory + kMaxControlBonus;
 
-static_assert(kMaxKillerCounterMoveScore < kCaptureBonus);
-static_assert(kMaxKillerCounterMoveScore < kPromotionBonus);
-
-static_assert(kMaxKillerMoveScore < kMinKillerCounterMoveScore);
-
-static_assert(kMaxCounterMoveScore < kMinKillerMoveScore);
-
-static_assert(kMaxRegularQuiet < kMinCounterMoveScore);
+static_assert(kMaxRegularQuiet < kCaptureBonus);
+static_assert(kMaxRegularQuiet < kPromotionBonus);
 }  // namespace checks
 
 [[nodiscard]] FORCE_INLINE MoveEvalT
@@ -74,9 +57,20 @@ scoreQueenPromotion(const Move& /*move*/, const GameState& /*gameState*/) {
 
 FORCE_INLINE MoveOrderer::MoveOrderer(
         StackVector<Move>&& moves, StackVector<MoveEvalT>&& moveScores, const int firstMoveIdx)
-    : state_(State::Init),
-      moves_(std::move(moves)),
-      moveScores_(std::move(moveScores)),
+    : MoveOrderer(std::move(moves), std::move(moveScores), firstMoveIdx, QuietMoveContext{}) {}
+
+FORCE_INLINE MoveOrderer::MoveOrderer(
+        StackVector<Move>&& tacticalMoves,
+        StackVector<MoveEvalT>&& tacticalMoveScores,
+        const int firstMoveIdx,
+        const QuietMoveContext& quietMoveContext)
+    : state_(State::GoodTactical),
+      moves_(std::move(tacticalMoves)),
+      moveScores_(std::move(tacticalMoveScores)),
+      quietMoveContext_(quietMoveContext),
+      killersAndCounter_{},
+      killersAndCounterTypes_{},
+      numKillersAndCounter_(0),
       currentMoveIdx_(firstMoveIdx),
       firstLosingCaptureIdx_(moves_.size()),
       firstQuietIdx_(moves_.size()),
@@ -85,25 +79,18 @@ FORCE_INLINE MoveOrderer::MoveOrderer(
 FORCE_INLINE std::optional<Move> MoveOrderer::getNextBestMove(const GameState& gameState) {
     MY_ASSERT(
             0 <= firstLosingCaptureIdx_ && firstLosingCaptureIdx_ <= firstQuietIdx_
-            && firstQuietIdx_ <= moves_.size());
-    MY_ASSERT(0 <= currentMoveIdx_ && currentMoveIdx_ <= moves_.size());
+            && firstQuietIdx_ == moves_.size());
 
     switch (state_) {
-        case State::Init: {
-            partitionTacticalMoves();
-
-            state_ = State::GoodTactical;
-            [[fallthrough]];
-        }
-
         case State::GoodTactical: {
-            MY_ASSERT(currentMoveIdx_ <= firstLosingCaptureIdx_);
+            MY_ASSERT(0 <= currentMoveIdx_ && currentMoveIdx_ <= firstLosingCaptureIdx_);
 
             while (currentMoveIdx_ < firstLosingCaptureIdx_) {
-                const int bestMoveIdx =
-                        findHighestScoringMove(currentMoveIdx_, firstLosingCaptureIdx_);
+                const int bestMoveIdx = findHighestScoringMove(
+                        moveScores_, currentMoveIdx_, firstLosingCaptureIdx_);
 
                 const Move bestMove = moves_[bestMoveIdx];
+                MY_ASSERT(isCaptureOrQueenPromo(bestMove));
 
                 if (isCapture(bestMove.flags)) {
                     const bool isNonLosing = staticExchangeEvaluationMeetsBound(
@@ -129,34 +116,49 @@ FORCE_INLINE std::optional<Move> MoveOrderer::getNextBestMove(const GameState& g
                 return bestMove;
             }
 
-            state_          = State::Quiets;
-            currentMoveIdx_ = firstQuietIdx_;
+            state_ = State::KillersAndCounter;
+            selectKillersAndCounter(gameState);
+            currentMoveIdx_ = 0;
+            [[fallthrough]];
+        }
+
+        case State::KillersAndCounter: {
+            MY_ASSERT(0 <= currentMoveIdx_ && currentMoveIdx_ <= numKillersAndCounter_);
+
+            if (currentMoveIdx_ < numKillersAndCounter_) {
+                lastMoveType_ = killersAndCounterTypes_[currentMoveIdx_];
+                return killersAndCounter_[currentMoveIdx_++];
+            }
+
+            state_ = State::Quiets;
+            generateQuietMoves(gameState);
             [[fallthrough]];
         }
 
         case State::Quiets: {
-            MY_ASSERT(firstQuietIdx_ <= currentMoveIdx_ && currentMoveIdx_ <= moves_.size());
+            StackVector<Move>& quietMoves           = *quietMoves_;
+            StackVector<MoveEvalT>& quietMoveScores = *quietMoveScores_;
 
-            if (currentMoveIdx_ < moves_.size()) {
-                const int bestMoveIdx = findHighestScoringMove(currentMoveIdx_, moves_.size());
+            MY_ASSERT(0 <= currentMoveIdx_ && currentMoveIdx_ <= quietMoves.size());
 
-                const Move bestMove = moves_[bestMoveIdx];
+            if (currentMoveIdx_ < quietMoves.size()) {
+                const int bestMoveIdx =
+                        findHighestScoringMove(quietMoveScores, currentMoveIdx_, quietMoves.size());
+
+                const Move bestMove = quietMoves[bestMoveIdx];
+                MY_ASSERT(!isCaptureOrQueenPromo(bestMove));
 #ifdef TRACK_CUTOFF_STATISTICS
-                const int bestScore = moveScores_[bestMoveIdx];
+                const int bestScore = quietMoveScores[bestMoveIdx];
 #endif
 
                 // 'destructive swap'
-                moves_[bestMoveIdx]      = moves_[currentMoveIdx_];
-                moveScores_[bestMoveIdx] = moveScores_[currentMoveIdx_];
+                quietMoves[bestMoveIdx]      = quietMoves[currentMoveIdx_];
+                quietMoveScores[bestMoveIdx] = quietMoveScores[currentMoveIdx_];
 
                 ++currentMoveIdx_;
 
 #ifdef TRACK_CUTOFF_STATISTICS
-                lastMoveType_ = bestScore > kMinKillerCounterMoveScore ? MoveType::KillerCounterMove
-                              : bestScore > kMinKillerMoveScore        ? MoveType::KillerMove
-                              : bestScore > kMinCounterMoveScore       ? MoveType::CounterMove
-                              : bestScore > 0                          ? MoveType::GoodHistory
-                                                                       : MoveType::BadHistory;
+                lastMoveType_ = bestScore > 0 ? MoveType::GoodHistory : MoveType::BadHistory;
 #else
                 lastMoveType_ = MoveType::Quiet;
 #endif
@@ -209,7 +211,7 @@ FORCE_INLINE std::optional<Move> MoveOrderer::getNextBestMoveQuiescence() {
     }
     MY_ASSERT(0 <= currentMoveIdx_ && currentMoveIdx_ < moves_.size());
 
-    const int bestMoveIdx = findHighestScoringMove(currentMoveIdx_, moves_.size());
+    const int bestMoveIdx = findHighestScoringMove(moveScores_, currentMoveIdx_, moves_.size());
 
     const Move bestMove = moves_[bestMoveIdx];
 
@@ -231,69 +233,133 @@ FORCE_INLINE MoveType MoveOrderer::getLastMoveType() const {
 }
 
 FORCE_INLINE void MoveOrderer::skipRemainingQuiets() {
-    MY_ASSERT(state_ == State::Quiets);
+    MY_ASSERT(state_ == State::KillersAndCounter || state_ == State::Quiets);
     state_          = State::LosingCaptures;
     currentMoveIdx_ = firstLosingCaptureIdx_;
 }
 
-FORCE_INLINE int MoveOrderer::findHighestScoringMove(const int startIdx, const int endIdx) const {
-    // Select best move based on pre-calculated scores using a simple linear search.
-    // If the best move is then swapped to the front, repeated calls of this function end up doing
-    // a selection sort.
+FORCE_INLINE void MoveOrderer::selectKillersAndCounter(const GameState& gameState) {
+    MY_ASSERT(state_ == State::KillersAndCounter);
+    MY_ASSERT(quietMoveContext_.moveScorer != nullptr);
 
-    int bestMoveIdx         = startIdx;
-    MoveEvalT bestMoveScore = moveScores_[startIdx];
+    const QuietMoveContext& context = quietMoveContext_;
 
-    for (int moveIdx = startIdx + 1; moveIdx < endIdx; ++moveIdx) {
-        if (moveScores_[moveIdx] > bestMoveScore) {
-            bestMoveScore = moveScores_[moveIdx];
-            bestMoveIdx   = moveIdx;
-        }
+    numKillersAndCounter_ = 0;
+
+    // isLegal doesn't handle evasions, and in check most killers wouldn't be legal anyway.
+    if (gameState.isInCheck(*context.boardControl)) {
+        return;
     }
 
-    return bestMoveIdx;
-}
+    const auto& killerMoves = context.moveScorer->getKillerMoves(context.ply);
+    const Move counterMove =
+            context.moveScorer->getCounterMove(context.lastMove, gameState.getSideToMove());
+    const auto& historyForSide = context.moveScorer->history_[(int)gameState.getSideToMove()];
 
-FORCE_INLINE void MoveOrderer::partitionTacticalMoves() {
-    MY_ASSERT(state_ == State::Init);
+    std::array<int, kMaxKillersAndCounter> scores{};
 
-    const auto isTactical = [](const Move& move) {
-        return isCaptureOrQueenPromo(move);
-    };
+    const auto tryAdd = [&](const Move& move) {
+        if (move.pieceToMove == Piece::Invalid) {
+            return;
+        }
+
+        const auto selected = std::span(killersAndCounter_).first(numKillersAndCounter_);
+        if (std::ranges::find(selected, move) != selected.end()) {
+            return;
+        }
+
+        if (move == context.moveToIgnore) {
+            return;
+        }
+        if (context.movesToSearch
+            && std::ranges::find(*context.movesToSearch, move) == context.movesToSearch->end()) {
+            return;
+        }
 
-    // Partition moves into tactical and quiet moves using Hoare's partitioning scheme.
-    int i = currentMoveIdx_ - 1;
-    int j = moves_.size();
+        if (!gameState.isPseudoLegal(move) || !gameState.isLegal(move, *context.boardControl)) {
+            return;
+        }
 
-    while (true) {
-        do {
-            ++i;
-        } while (i < j && isTactical(moves_[i]));
+        const bool isKiller  = std::ranges::find(killerMoves, move) != killerMoves.end();
+        const bool isCounter = move == counterMove;
 
-        do {
-            --j;
-        } while (j >= i && !isTactical(moves_[j]));
+        // Killers that are also the counter move go first, then the other killers, then the
+        // counter move. Ties are broken by history.
+        const int score = (isKiller ? 2 * kMaxHistory + 1 : 0) + (isCounter ? kMaxHistory + 1 : 0)
+                        + historyForSide[(int)move.pieceToMove][(int)move.to];
 
-        if (i >= j) {
-            firstQuietIdx_ = i;
-            break;
+#ifdef TRACK_CUTOFF_STATISTICS
+        const MoveType moveType = isKiller && isCounter ? MoveType::KillerCounterMove
+                                : isKiller              ? MoveType::KillerMove
+                                                        : MoveType::CounterMove;
+#else
+        const MoveType moveType = MoveType::Quiet;
+#endif
+
+        // Insertion sort on at most three moves.
+        int insertIdx = numKillersAndCounter_;
+        for (; insertIdx > 0 && scores[insertIdx - 1] < score; --insertIdx) {
+            killersAndCounter_[insertIdx]      = killersAndCounter_[insertIdx - 1];
+            killersAndCounterTypes_[insertIdx] = killersAndCounterTypes_[insertIdx - 1];
+            scores[insertIdx]                  = scores[insertIdx - 1];
         }
+        killersAndCounter_[insertIdx]      = move;
+        killersAndCounterTypes_[insertIdx] = moveType;
+        scores[insertIdx]                  = score;
+        ++numKillersAndCounter_;
+    };
 
-        std::swap(moves_[i], moves_[j]);
-        std::swap(moveScores_[i], moveScores_[j]);
+    for (const Move& killerMove : killerMoves) {
+        tryAdd(killerMove);
     }
+    tryAdd(counterMove);
+}
+
+FORCE_INLINE void MoveOrderer::generateQuietMoves(const GameState& gameState) {
+    MY_ASSERT(state_ == State::Quiets);
+    MY_ASSERT(quietMoveContext_.moveScorer != nullptr);
+
+    const QuietMoveContext& context = quietMoveContext_;
 
-    MY_ASSERT(firstQuietIdx_ <= moves_.size());
-#ifndef NDEBUG
-    for (int moveIdx = currentMoveIdx_; moveIdx < firstQuietIdx_; ++moveIdx) {
-        MY_ASSERT(isTactical(moves_[moveIdx]));
+    quietMoves_.emplace(gameState.generateQuietMoves(*context.moveStack, *context.boardControl));
+
+    int firstMoveIdx = 0;
+    context.moveScorer->ignoreMoves(
+            *quietMoves_,
+            /*isTacticalBatch*/ false,
+            context.moveToIgnore,
+            context.movesToSearch,
+            firstMoveIdx);
+
+    // The killer and counter moves have already been searched.
+    for (int i = 0; i < numKillersAndCounter_; ++i) {
+        context.moveScorer->ignoreMove(
+                killersAndCounter_[i], *quietMoves_, firstMoveIdx, /*ignoredMoveShouldExist*/ true);
     }
-    for (int moveIdx = firstQuietIdx_; moveIdx < moves_.size(); ++moveIdx) {
-        MY_ASSERT(!isTactical(moves_[moveIdx]));
+
+    quietMoveScores_.emplace(context.moveScorer->scoreMoves(
+            *quietMoves_, firstMoveIdx, gameState, *context.boardControl));
+
+    currentMoveIdx_ = firstMoveIdx;
+}
+
+FORCE_INLINE int MoveOrderer::findHighestScoringMove(
+        const StackVector<MoveEvalT>& moveScores, const int startIdx, const int endIdx) {
+    // Select best move based on pre-calculated scores using a simple linear search.
+    // If the best move is then swapped to the front, repeated calls of this function end up doing
+    // a selection sort.
+
+    int bestMoveIdx         = startIdx;
+    MoveEvalT bestMoveScore = moveScores[startIdx];
+
+    for (int moveIdx = startIdx + 1; moveIdx < endIdx; ++moveIdx) {
+        if (moveScores[moveIdx] > bestMoveScore) {
+            bestMoveScore = moveScores[moveIdx];
+            bestMoveIdx   = moveIdx;
+        }
     }
-#endif
 
-    firstLosingCaptureIdx_ = firstQuietIdx_;
+    return bestMoveIdx;
 }
 
 MoveScorer::MoveScorer(const Evaluator& evaluator) : evaluator_(evaluator) {
@@ -340,20 +406,31 @@ FORCE_INLINE void MoveScorer::reportCutoff(
 }
 
 FORCE_INLINE MoveOrderer MoveScorer::getMoveOrderer(
-        StackVector<Move>&& moves,
+        StackOfVectors<Move>& moveStack,
         const std::optional<Move>& moveToIgnore,
+        const std::vector<Move>* movesToSearch,
         const GameState& gameState,
         const BoardControl& boardControl,
         const Move& lastMove,
         const int ply) const {
+    auto moves = gameState.generateTacticalMoves(moveStack, boardControl);
+
     int moveIdx = 0;
-    if (moveToIgnore) {
-        ignoreMove(*moveToIgnore, moves, moveIdx, /*ignoredMoveShouldExist*/ true);
-    }
+    ignoreMoves(moves, /*isTacticalBatch*/ true, moveToIgnore, movesToSearch, moveIdx);
 
-    auto moveScores = scoreMoves(moves, moveIdx, gameState, boardControl, lastMove, ply);
+    auto moveScores = scoreMoves(moves, moveIdx, gameState, boardControl);
 
-    return MoveOrderer(std::move(moves), std::move(moveScores), moveIdx);
+    return MoveOrderer(
+            std::move(moves),
+            std::move(moveScores),
+            moveIdx,
+            {.moveScorer    = this,
+             .moveStack     = &moveStack,
+             .boardControl  = &boardControl,
+             .moveToIgnore  = moveToIgnore,
+             .movesToSearch = movesToSearch,
+             .lastMove      = lastMove,
+             .ply           = ply});
 }
 
 FORCE_INLINE MoveOrderer MoveScorer::getMoveOrdererQuiescence(
@@ -629,29 +706,47 @@ FORCE_INLINE void MoveScorer::ignoreMove(
         StackVector<Move>& moves,
         int& moveIdx,
         const bool ignoredMoveShouldExist) const {
-    const auto hashMoveIt = std::find(moves.begin(), moves.end(), moveToIgnore);
+    const auto hashMoveIt = std::find(moves.begin() + moveIdx, moves.end(), moveToIgnore);
 
     MY_ASSERT_DEBUG(IMPLIES(ignoredMoveShouldExist, hashMoveIt != moves.end()));
     (void)ignoredMoveShouldExist;
 
     if (hashMoveIt != moves.end()) {
-        std::swap(*hashMoveIt, moves.front());
+        std::swap(*hashMoveIt, moves[moveIdx]);
         ++moveIdx;
     }
 }
 
+FORCE_INLINE void MoveScorer::ignoreMoves(
+        StackVector<Move>& moves,
+        const bool isTacticalBatch,
+        const std::optional<Move>& moveToIgnore,
+        const std::vector<Move>* movesToSearch,
+        int& moveIdx) const {
+    if (moveToIgnore) {
+        // The move to ignore is only in one of the batches.
+        const bool ignoredMoveShouldExist = isCaptureOrQueenPromo(*moveToIgnore) == isTacticalBatch;
+        ignoreMove(*moveToIgnore, moves, moveIdx, ignoredMoveShouldExist);
+    }
+
+    if (movesToSearch) {
+        for (int i = moveIdx; i < moves.size(); ++i) {
+            if (std::ranges::find(*movesToSearch, moves[i]) == movesToSearch->end()) {
+                std::swap(moves[i], moves[moveIdx]);
+                ++moveIdx;
+            }
+        }
+    }
+}
+
 StackVector<MoveEvalT> MoveScorer::scoreMoves(
         const StackVector<Move>& moves,
         const int firstMoveIdx,
         const GameState& gameState,
-        const BoardControl& boardControl,
-        const Move& lastMove,
-        const int ply) const {
+        const BoardControl& boardControl) const {
     StackVector<MoveEvalT> scores = moveScoreStack_.makeStackVector();
 
     const auto& historyForSide = history_[(int)gameState.getSideToMove()];
-    const auto& killerMoves    = getKillerMoves(ply);
-    const Move counterMove     = getCounterMove(lastMove, gameState.getSideToMove());
 
     const int enemySideIdx = (int)nextSide(gameState.getSideToMove());
 
@@ -701,18 +796,6 @@ StackVector<MoveEvalT> MoveScorer::scoreMoves(
             moveScore += scoreQueenPromotion(move, gameState);
         }
 
-        if (!isCapture(move) && !isPromotion(move.flags)) {
-            for (const Move& killerMove : killerMoves) {
-                if (move == killerMove) {
-                    moveScore += kKillerMoveBonus;
-                }
-            }
-
-            if (move == counterMove) {
-                moveScore += kCounterMoveBonus;
-            }
-        }
-
         scores.push_back(moveScore);
     }
 
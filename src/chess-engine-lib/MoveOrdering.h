@@ -9,10 +9,12 @@
 #include <optional>
 #include <ostream>
 #include <utility>
+#include <vector>
 
 using MoveEvalT = int;
 
 class Evaluator;
+class MoveScorer;
 
 //#define TRACK_CUTOFF_STATISTICS
 
@@ -35,6 +37,13 @@ enum class MoveType {
 
 static constexpr std::size_t kNumMoveTypes = (std::size_t)MoveType::NumMoveTypes;
 
+// Move ordering for the main search is staged: the tactical moves are generated and scored up
+// front. Once all good tactical moves have been returned, the killer and counter moves are tried if
+// they're legal in this position, and only then are the remaining quiet moves generated.
+// Use MoveScorer::getMoveOrderer to create such an orderer, and getNextBestMove to iterate it.
+//
+// For quiescence search all moves are passed to the constructor, and the orderer is iterated using
+// getNextBestMoveQuiescence.
 class MoveOrderer {
   public:
     MoveOrderer(StackVector<Move>&& moves, StackVector<MoveEvalT>&& moveScores, int firstMoveIdx);
@@ -50,22 +59,61 @@ class MoveOrderer {
     static constexpr int kCaptureLosingThreshold = -20;
 
   private:
+    friend class MoveScorer;
+
     enum class State {
-        Init,
         GoodTactical,
+        KillersAndCounter,
         Quiets,
         LosingCaptures,
         Done,
     };
 
-    void partitionTacticalMoves();
-    [[nodiscard]] int findHighestScoringMove(int startIdx, int endIdx) const;
+    // Everything needed to select the killer and counter moves, and to generate and score the quiet
+    // moves.
+    struct QuietMoveContext {
+        const MoveScorer* moveScorer           = nullptr;
+        StackOfVectors<Move>* moveStack        = nullptr;
+        const BoardControl* boardControl       = nullptr;
+        std::optional<Move> moveToIgnore       = std::nullopt;
+        const std::vector<Move>* movesToSearch = nullptr;
+        Move lastMove                          = {};
+        int ply                                = 0;
+    };
+
+    MoveOrderer(
+            StackVector<Move>&& tacticalMoves,
+            StackVector<MoveEvalT>&& tacticalMoveScores,
+            int firstMoveIdx,
+            const QuietMoveContext& quietMoveContext);
+
+    void selectKillersAndCounter(const GameState& gameState);
+    void generateQuietMoves(const GameState& gameState);
+
+    [[nodiscard]] static int findHighestScoringMove(
+            const StackVector<MoveEvalT>& moveScores, int startIdx, int endIdx);
 
     State state_;
 
+    // In the main search, these only contain the tactical moves.
     StackVector<Move> moves_;
     StackVector<MoveEvalT> moveScores_;
 
+    // Declared after moves_ and moveScores_ so that they're destroyed first: they're allocated
+    // later from the same stacks.
+    std::optional<StackVector<Move>> quietMoves_;
+    std::optional<StackVector<MoveEvalT>> quietMoveScores_;
+
+    QuietMoveContext quietMoveContext_;
+
+    // The legal killer and counter moves, without duplicates.
+    static constexpr int kMaxKillersAndCounter = 3;
+    std::array<Move, kMaxKillersAndCounter> killersAndCounter_;
+    std::array<MoveType, kMaxKillersAndCounter> killersAndCounterTypes_;
+    int numKillersAndCounter_;
+
+    // While in the KillersAndCounter state this indexes into killersAndCounter_, while in the Quiets
+    // state into quietMoves_, and otherwise into moves_.
     int currentMoveIdx_;
     int firstLosingCaptureIdx_;
     int firstQuietIdx_;
@@ -87,9 +135,13 @@ class MoveScorer {
             int ply,
             int depth);
 
+    // Generates the tactical moves; the quiet moves are generated lazily by the move orderer.
+    // moveToIgnore is skipped, and if movesToSearch is non-null only moves in it are returned.
+    // Both moveStack and movesToSearch must outlive the returned move orderer.
     [[nodiscard]] MoveOrderer getMoveOrderer(
-            StackVector<Move>&& moves,
+            StackOfVectors<Move>& moveStack,
             const std::optional<Move>& moveToIgnore,
+            const std::vector<Move>* movesToSearch,
             const GameState& gameState,
             const BoardControl& boardControl,
             const Move& lastMove,
@@ -108,6 +160,8 @@ class MoveScorer {
     void printCutoffStatistics(std::ostream& out) const;
 
   private:
+    friend class MoveOrderer;
+
     static constexpr std::size_t kNumKillerMoves = 2;
     static constexpr int kMaxDepth               = 100;
 
@@ -156,13 +210,19 @@ class MoveScorer {
             int& moveIdx,
             bool ignoredMoveShouldExist) const;
 
+    // Moves the moves that should not be searched to the front of a batch of staged moves.
+    void ignoreMoves(
+            StackVector<Move>& moves,
+            bool isTacticalBatch,
+            const std::optional<Move>& moveToIgnore,
+            const std::vector<Move>* movesToSearch,
+            int& moveIdx) const;
+
     [[nodiscard]] StackVector<MoveEvalT> scoreMoves(
             const StackVector<Move>& moves,
             const int firstMoveIdx,
             const GameState& gameState,
-            const BoardControl& boardControl,
-            const Move& lastMove,
-            int ply) const;
+            const BoardControl& boardControl) const;
 
     [[nodiscard]] StackVector<MoveEvalT> scoreMovesQuiesce(
             const StackVector<Move>& moves,
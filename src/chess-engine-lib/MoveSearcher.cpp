@@ -1,26 +1,37 @@
 #include "MoveSearcher.h"
 
+#include "ActiveMovesTable.h"
 #include "Eval.h"
 #include "Math.h"
 #include "MoveOrdering.h"
+#include "Numa.h"
 #include "SEE.h"
 #include "Syzygy.h"
 #include "TTable.h"
+#include "WorkerThread.h"
 
 #include <algorithm>
 #include <array>
 #include <atomic>
 #include <bit>
+#include <future>
 #include <limits>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 #include <cstdint>
-#include <cstring>
 
 class MoveSearcher::Impl {
   public:
     Impl(const TimeManager& timeManager, const Evaluator& evaluator);
 
+    // Construct a helper searcher for multi-threaded search. The helper shares the transposition
+    // table of the main searcher.
+    Impl(const TimeManager& timeManager, const Evaluator& evaluator, SearchTTable& sharedTTable);
+
+    ~Impl();
+
     void setFrontEnd(IFrontEnd* frontEnd);
 
     void setSyzygyEnabled(bool enabled);
@@ -38,6 +49,30 @@ class MoveSearcher::Impl {
 
     void interruptSearch();
 
+    void setNumThreads(int numThreads);
+
+    void setNumaBinding(bool enabled);
+
+    void setEvalHashTableSize(int sizeInMb);
+
+    void setNnueNetwork(const std::shared_ptr<const NnueNetwork>& network);
+
+    enum class SmpMode {
+        // Threads share the transposition table, and helpers skip depths in a staggered pattern.
+        LazySmp,
+        // Like LazySmp, but without skipping depths; moves that another thread is searching are
+        // deferred.
+        Abdada,
+        // Helpers only search root moves handed out by the main thread.
+        RootSplit,
+    };
+
+    void setSmpMode(SmpMode mode);
+
+    void startHelperSearches(const GameState& gameState);
+
+    void stopHelperSearches();
+
     [[nodiscard]] SearchStatistics getSearchStatistics() const;
 
     void resetSearchStatistics();
@@ -46,11 +81,26 @@ class MoveSearcher::Impl {
 
     void setTTableSize(int requestedSizeInMb);
 
+    void waitUntilReady();
+
     [[nodiscard]] std::optional<RootNodeInfo> getRootNodeInfo(const GameState& gameState) const;
 
   private:
     // == Types ==
 
+    // A helper searcher for Lazy SMP, together with the state it needs to search on its own thread.
+    struct HelperThread;
+
+    // Root moves that are searched in parallel by all threads, with a shared alpha.
+    struct RootSplit;
+
+    // A move whose search was postponed, together with the information needed to search it.
+    struct PendingMove {
+        Move move;
+        MoveType moveType;
+        int reduction;
+    };
+
     // Outcome of searching a single move; signals to main search whether to continue or stop.
     enum class SearchMoveOutcome {
         Continue,
@@ -69,11 +119,12 @@ class MoveSearcher::Impl {
             Move bestMove,
             int depth,
             HashT hash,
-            bool isPvNode);
+            bool isPvNode,
+            EvalT staticEval);
 
     void storeEgtbValueInTTable(const EvalT value, int depth, HashT hash);
 
-    void storeNullMoveScoreInTTable(const EvalT value, int depth, HashT hash);
+    void storeNullMoveScoreInTTable(const EvalT value, int depth, HashT hash, EvalT staticEval);
 
     // Extract the principal variation from the transposition table.
     [[nodiscard]] std::vector<Move> extractPv(
@@ -81,6 +132,30 @@ class MoveSearcher::Impl {
 
     [[nodiscard]] bool shouldStopSearch() const;
 
+    // Number of threads to use for allocating and clearing the transposition table.
+    [[nodiscard]] int getNumTTableThreads() const;
+
+    // Iterative deepening loop run by helper threads until interrupted.
+    void runHelperSearch(GameState gameState, StackOfVectors<Move>& stack, int threadIdx);
+
+    // Search the remaining root moves using all threads. Updates alpha, bestScore, bestMove and
+    // movesSearched like searchMove would.
+    [[nodiscard]] SearchMoveOutcome searchRootMovesInParallel(
+            const GameState& gameState,
+            const std::vector<PendingMove>& moves,
+            int depth,
+            EvalT& alpha,
+            EvalT beta,
+            StackOfVectors<Move>& stack,
+            EvalT& bestScore,
+            Move& bestMove,
+            int& movesSearched,
+            int lastNullMovePly,
+            bool useScoutSearch);
+
+    // Take moves from the root split and search them until none are left. Run by all threads.
+    void searchRootSplitMoves(RootSplit& split, GameState gameState, StackOfVectors<Move>& stack);
+
     [[nodiscard]] bool shouldProbeSyzygy(const GameState& gameState, int ply, int depth) const;
 
     [[nodiscard]] bool captureWillProbeSyzygy(const GameState& gameState, int depth) const;
@@ -153,16 +228,48 @@ class MoveSearcher::Impl {
     bool rootInTb_      = false;
     bool syzygyEnabled_ = false;
 
+    // If set, search threads are bound to NUMA nodes, round-robin by thread index.
+    bool bindToNumaNodes_   = false;
+    bool mainThreadIsBound_ = false;
+
+    // If set, newGame() ages out all entries in the transposition table instead of zeroing it.
+    bool lazyTTableClear_ = false;
+
     std::uint8_t tTableTick_ = 0;
 
     int syzygyMinProbeDepth_ = 1;
 
-    SearchTTable tTable_ = {};
+    // Only used by the main searcher; helper searchers refer to the table of the main searcher.
+    SearchTTable ownedTTable_ = {};
+
+    SearchTTable& tTable_;
+
+    SmpMode smpMode_ = SmpMode::LazySmp;
+
+    // Shared table of moves being searched, for ABDADA. Null in the other modes. Only the main
+    // searcher owns the table; helpers refer to the table of the main searcher.
+    std::unique_ptr<ActiveMovesTable> ownedActiveMoves_ = nullptr;
+    ActiveMovesTable* activeMoves_                     = nullptr;
+
+    // Pending resize or clear of the transposition table. While this is valid, only the task may
+    // access the table.
+    std::future<void> tTableTask_;
+
+    // Whether the allocation of the transposition table should be reported once it's complete.
+    bool reportTTableAllocation_ = false;
 
     MoveScorer moveScorer_;
 
     SearchStatistics searchStatistics_ = {};
 
+    // The node counters are kept outside of searchStatistics_ so that the main searcher can read
+    // the node counts of the helper searchers while they are searching. Only the owning thread
+    // writes to them.
+    std::atomic<std::uint64_t> normalNodesSearched_ = 0;
+    std::atomic<std::uint64_t> qNodesSearched_      = 0;
+
+    std::vector<std::unique_ptr<HelperThread>> helperThreads_;
+
     const std::vector<Move>* rootMovesToSearch_ = nullptr;
 
     IFrontEnd* frontEnd_ = nullptr;
@@ -172,6 +279,67 @@ class MoveSearcher::Impl {
     const Evaluator& evaluator_;
 };
 
+struct MoveSearcher::Impl::HelperThread {
+    struct State {
+        State(const Evaluator& mainEvaluator, SearchTTable& sharedTTable)
+            : evaluator(
+                      mainEvaluator.getParams(),
+                      mainEvaluator.usesPawnKingEvalHashTable(),
+                      mainEvaluator.getEvalHashTableSizeInMb()),
+              searcher(timeManager, evaluator, sharedTTable) {
+            evaluator.setNnueNetwork(mainEvaluator.getNnueNetwork());
+            stack.reserve(1'000);
+        }
+
+        // Helpers search until they're interrupted by the main searcher, so they use an infinite
+        // search configuration.
+        TimeManager timeManager;
+        Evaluator evaluator;
+        StackOfVectors<Move> stack;
+        Impl searcher;
+    };
+
+    // If numaNode is set, the thread is bound to that NUMA node.
+    HelperThread(
+            const Evaluator& mainEvaluator,
+            SearchTTable& sharedTTable,
+            const std::optional<int> numaNode) {
+        // Construct the state on the helper thread itself, after binding it, so that the memory
+        // is allocated on the helper's NUMA node.
+        thread.start([this, &mainEvaluator, &sharedTTable, numaNode]() {
+            if (numaNode) {
+                bindCurrentThreadToNumaNode(*numaNode);
+            }
+            state = std::make_unique<State>(mainEvaluator, sharedTTable);
+        });
+        thread.wait();
+    }
+
+    std::unique_ptr<State> state;
+
+    // The thread is kept alive between searches, so that starting a search doesn't require
+    // creating new threads. Declared last so that it's destroyed (and joined) before the state it
+    // uses.
+    WorkerThread thread;
+};
+
+struct MoveSearcher::Impl::RootSplit {
+    const std::vector<PendingMove>& moves;
+    const int depth;
+    const EvalT beta;
+    const int lastNullMovePly;
+    const bool useScoutSearch;
+
+    std::atomic<std::size_t> nextMoveIdx = 0;
+
+    // Protects the members below.
+    std::mutex mutex{};
+    EvalT alpha;
+    EvalT bestScore;
+    Move bestMove;
+    int movesSearched = 0;
+};
+
 namespace {
 
 [[nodiscard]] FORCE_INLINE bool nullMovePruningAllowed(
@@ -284,15 +452,9 @@ FORCE_INLINE void updateMateDistance(EvalT& score) {
     }
 }
 
-// Compute the delta between two wrapping counters
-FORCE_INLINE std::int8_t computeWrappingTickDelta(std::uint8_t tickA, std::uint8_t tickB) {
-    const std::uint8_t wrappingTickDelta = tickA - tickB;
-    std::int8_t signedTickDelta{};
-    // 2's complement is guaranteed
-    // if the absolute value of the true tick difference is <= 127, the resulting signedTickDelta
-    // is correct
-    std::memcpy(&signedTickDelta, &wrappingTickDelta, sizeof(wrappingTickDelta));
-    return signedTickDelta;
+FORCE_INLINE void incrementNodeCounter(std::atomic<std::uint64_t>& counter) {
+    // Only the owning thread writes the counter, so we can avoid a (locked) read-modify-write.
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 }
 
 FORCE_INLINE std::optional<Move> getTTableMove(
@@ -301,16 +463,34 @@ FORCE_INLINE std::optional<Move> getTTableMove(
         return std::nullopt;
     }
 
+    const Piece pieceToMove = getPiece(gameState.getPieceOnSquare(payload.moveFrom));
+
+    // The table only stores the promotion piece; derive the other flags from the position.
+    MoveFlags moveFlags = (MoveFlags)getPromotionPiece(payload.moveFlags);
+
+    if (pieceToMove == Piece::Pawn && payload.moveTo == gameState.getEnPassantTarget()) {
+        moveFlags = moveFlags | MoveFlags::IsCapture | MoveFlags::IsEnPassant;
+    } else if (gameState.getPieceOnSquare(payload.moveTo) != ColoredPiece::Invalid) {
+        moveFlags = moveFlags | MoveFlags::IsCapture;
+    }
+
+    if (pieceToMove == Piece::King) {
+        const int fileDelta = fileFromPosition(payload.moveTo) - fileFromPosition(payload.moveFrom);
+        if (fileDelta == 2 || fileDelta == -2) {
+            moveFlags = moveFlags | MoveFlags::IsCastle;
+        }
+    }
+
     return Move{
-            .pieceToMove = getPiece(gameState.getPieceOnSquare(payload.moveFrom)),
+            .pieceToMove = pieceToMove,
             .from        = payload.moveFrom,
             .to          = payload.moveTo,
-            .flags       = payload.moveFlags,
+            .flags       = moveFlags,
     };
 }
 
 [[nodiscard]] FORCE_INLINE std::optional<EvalT> checkForcedEndState(
-        const GameState& gameState, StackOfVectors<Move>& stack) {
+        const GameState& gameState, StackOfVectors<Move>& stack, const Evaluator& evaluator) {
     if (gameState.isRepetition(/*repetitionThreshold =*/2)) {
         return (EvalT)0;
     }
@@ -324,7 +504,7 @@ FORCE_INLINE std::optional<Move> getTTableMove(
         }
     }
 
-    if (isInsufficientMaterial(gameState)) {
+    if (evaluator.isInsufficientMaterial(gameState)) {
         return (EvalT)0;
     }
 
@@ -336,8 +516,8 @@ FORCE_INLINE std::optional<Move> getTTableMove(
     const auto& newPayload = newEntry.payload;
     const auto& oldPayload = oldEntry.payload;
 
-    const int tickDelta        = computeWrappingTickDelta(newPayload.tick, oldPayload.tick);
-    const int compensatedDepth = (int)newPayload.depth + tickDelta;
+    const int age              = SearchTTable::computeAge(newPayload.tick, oldPayload.tick);
+    const int compensatedDepth = (int)newPayload.depth + age;
 
     if (compensatedDepth != (int)oldPayload.depth) {
         // If new entry is deeper (biased for recency), consider it more valuable.
@@ -380,15 +560,51 @@ calculateFutilityMargin(const int reducedDepth, const int movesSearched, const b
 }  // namespace
 
 MoveSearcher::Impl::Impl(const TimeManager& timeManager, const Evaluator& evaluator)
-    : moveScorer_(evaluator), timeManager_(timeManager), evaluator_(evaluator) {
+    : tTable_(ownedTTable_),
+      moveScorer_(evaluator),
+      timeManager_(timeManager),
+      evaluator_(evaluator) {
     setTTableSize(getDefaultTTableSizeInMb());
 }
 
+MoveSearcher::Impl::Impl(
+        const TimeManager& timeManager, const Evaluator& evaluator, SearchTTable& sharedTTable)
+    : tTable_(sharedTTable),
+      moveScorer_(evaluator),
+      timeManager_(timeManager),
+      evaluator_(evaluator) {}
+
+MoveSearcher::Impl::~Impl() {
+    stopHelperSearches();
+    waitUntilReady();
+}
+
 void MoveSearcher::Impl::setFrontEnd(IFrontEnd* frontEnd) {
     frontEnd_ = frontEnd;
 
     frontEnd_->addOption(
             FrontEndOption::createInteger("SyzygyProbeDepth", syzygyMinProbeDepth_, 1, 100));
+
+    frontEnd_->addOption(FrontEndOption::createInteger(
+            "Threads", 1, 1, kMaxThreads, [this](const int numThreads) {
+                setNumThreads(numThreads);
+            }));
+
+    frontEnd_->addOption(FrontEndOption::createAlternative(
+            "SmpMode",
+            "LazySMP",
+            {"LazySMP", "ABDADA", "RootSplit"},
+            [this](const std::string_view mode) {
+                setSmpMode(
+                        mode == "ABDADA"      ? SmpMode::Abdada
+                        : mode == "RootSplit" ? SmpMode::RootSplit
+                                              : SmpMode::LazySmp);
+            }));
+
+    frontEnd_->addOption(FrontEndOption::createBoolean(
+            "NumaBind", false, [this](const bool enabled) { setNumaBinding(enabled); }));
+
+    frontEnd_->addOption(FrontEndOption::createBoolean("LazyHashClear", lazyTTableClear_));
 }
 
 void MoveSearcher::Impl::setSyzygyEnabled(const bool enabled) {
@@ -399,9 +615,8 @@ void MoveSearcher::Impl::setSyzygyEnabled(const bool enabled) {
     syzygyEnabled_           = enabled;
     searchStatistics_.tbHits = searchStatistics_.tbHits.value_or(0);
 
-    if (tTable_.getNumInUse() > 0) {
-        tTable_.clear();
-    }
+    waitUntilReady();
+    tTable_.clear(getNumTTableThreads());
 }
 
 void MoveSearcher::Impl::newGame() {
@@ -413,10 +628,26 @@ void MoveSearcher::Impl::newGame() {
     rootInTb_ = false;
 
     moveScorer_.newGame();
+    for (const auto& helper : helperThreads_) {
+        helper->state->searcher.moveScorer_.newGame();
+    }
+
+    waitUntilReady();
 
-    tTable_.clear();
     tTableTick_ = 0;
 
+    if (lazyTTableClear_) {
+        // Start a new table epoch. Existing entries are treated as empty, and each bucket is zeroed
+        // when it's first written to.
+        tTable_.clearLazily();
+    } else {
+        // Clear in the background; the next search (or 'isready') waits for the clear to finish.
+        tTableTask_ = std::async(
+                std::launch::async, [this, numThreads = getNumTTableThreads()]() {
+                    tTable_.clear(numThreads);
+                });
+    }
+
     resetSearchStatistics();
 }
 
@@ -428,7 +659,8 @@ FORCE_INLINE void MoveSearcher::Impl::updateTTable(
         const Move bestMove,
         const int depth,
         const HashT hash,
-        const bool isPvNode) {
+        const bool isPvNode,
+        const EvalT staticEval) {
     ScoreType scoreType{};
     if (stoppedEarly) {
         if (bestScore > alphaOrig) {
@@ -462,9 +694,10 @@ FORCE_INLINE void MoveSearcher::Impl::updateTTable(
                     .depth     = (std::uint8_t)depth,
                     .tick      = tTableTick_,
                     .scoreType = scoreType,
-                    .moveFrom  = bestMove.from,
-                    .moveTo    = bestMove.to,
-                    .moveFlags = bestMove.flags,
+                    .moveFrom   = bestMove.from,
+                    .moveTo     = bestMove.to,
+                    .moveFlags  = bestMove.flags,
+                    .staticEval = staticEval,
             }};
 
     if (isPvNode) {
@@ -502,7 +735,7 @@ FORCE_INLINE void MoveSearcher::Impl::storeEgtbValueInTTable(
 }
 
 FORCE_INLINE void MoveSearcher::Impl::storeNullMoveScoreInTTable(
-        const EvalT value, const int depth, const HashT hash) {
+        const EvalT value, const int depth, const HashT hash, const EvalT staticEval) {
     BoardPosition moveFrom = (BoardPosition)0;
     BoardPosition moveTo   = (BoardPosition)0;
     MoveFlags moveFlags    = MoveFlags::None;
@@ -521,10 +754,11 @@ FORCE_INLINE void MoveSearcher::Impl::storeNullMoveScoreInTTable(
                     .score     = value,
                     .depth     = (std::uint8_t)depth,
                     .tick      = tTableTick_,
-                    .scoreType = ScoreType::LowerBound,
-                    .moveFrom  = moveFrom,
-                    .moveTo    = moveTo,
-                    .moveFlags = moveFlags,
+                    .scoreType  = ScoreType::LowerBound,
+                    .moveFrom   = moveFrom,
+                    .moveTo     = moveTo,
+                    .moveFlags  = moveFlags,
+                    .staticEval = staticEval,
             }};
 
     tTable_.store(entry, isTTEntryMoreValuable);
@@ -552,7 +786,7 @@ std::vector<Move> MoveSearcher::Impl::extractPv(
         pv.push_back(*move);
         (void)gameState.makeMove(*move);
 
-        if (checkForcedEndState(gameState, stack).has_value()) {
+        if (checkForcedEndState(gameState, stack, evaluator_).has_value()) {
             break;
         }
     }
@@ -561,8 +795,8 @@ std::vector<Move> MoveSearcher::Impl::extractPv(
 }
 
 FORCE_INLINE bool MoveSearcher::Impl::shouldStopSearch() const {
-    const std::uint64_t numNodes =
-            searchStatistics_.normalNodesSearched + searchStatistics_.qNodesSearched;
+    const std::uint64_t numNodes = normalNodesSearched_.load(std::memory_order_relaxed)
+                                 + qNodesSearched_.load(std::memory_order_relaxed);
     wasInterrupted_ = wasInterrupted_ || stopSearch_.exchange(false)
                    || timeManager_.shouldInterruptSearch(numNodes);
     return wasInterrupted_;
@@ -666,7 +900,7 @@ EvalT MoveSearcher::Impl::search(
     }
     const bool isPvNode = beta - alpha > 1;
 
-    ++searchStatistics_.normalNodesSearched;
+    incrementNodeCounter(normalNodesSearched_);
 
     if (isPvNode) {
         searchStatistics_.selectiveDepth = max(searchStatistics_.selectiveDepth, ply);
@@ -680,7 +914,7 @@ EvalT MoveSearcher::Impl::search(
     }
 
     if (ply > 0) {
-        if (const auto endStateValue = checkForcedEndState(gameState, stack)) {
+        if (const auto endStateValue = checkForcedEndState(gameState, stack, evaluator_)) {
             // Exact value
             return *endStateValue;
         }
@@ -694,38 +928,8 @@ EvalT MoveSearcher::Impl::search(
         depth += extension;
     }
 
-    const bool boundsAreMate = isMate(alpha) || isMate(beta);
-
-    constexpr int kMaxFutilityPruningDepth = 5;
-    const bool futilityPruningEnabled      = depth <= kMaxFutilityPruningDepth && !boundsAreMate;
-
-    constexpr int kMaxReverseFutilityPruningDepth = 5;
-    const bool reverseFutilityPruningEnabled =
-            !isPvNode && !isInCheck && depth <= kMaxReverseFutilityPruningDepth && !boundsAreMate;
-
-    EvalT staticEval = -kInfiniteEval;
-    if (futilityPruningEnabled || reverseFutilityPruningEnabled) {
-        staticEval = evaluator_.evaluate(gameState, boardControl);
-    }
-    EvalT eval = staticEval;
-
-    // If we just did eval, we can now get the pin bit board for free.
-    const std::optional<BitBoard> enemyPinBitBoard =
-            gameState.getCalculatedPinBitBoard(nextSide(gameState.getSideToMove()));
-
-    std::optional<GameState::DirectCheckBitBoards> directCheckBitBoards = std::nullopt;
-
-    if (reverseFutilityPruningEnabled) {
-        static constexpr EvalT futilityMarginPerDepth = 140;
-        const int futilityValue                       = staticEval - futilityMarginPerDepth * depth;
-
-        if (futilityValue >= beta) {
-            // Return a conservative lower bound (fail-hard).
-            return beta;
-        }
-    }
-
     // Probe the transposition table and use the stored score and/or move if we get a hit.
+    // This is done before the static eval, so that we don't need to evaluate on a cutoff.
     auto ttHit = tTable_.probe(gameState.getBoardHash());
 
     if (rootInTb_ && ttHit.has_value() && ttHit->payload.scoreType == ScoreType::EGTB) {
@@ -766,6 +970,52 @@ EvalT MoveSearcher::Impl::search(
             }
         }
 
+        hashMove = getTTableMove(ttInfo, gameState);
+    }
+
+    // Internal iterative reduction: without a hash move the move ordering is much worse, so a full
+    // depth search of this node is expensive. Search it at a reduced depth instead; if it matters,
+    // the next iteration will find it in the ttable, with a move.
+    constexpr int kMinIirDepth = 4;
+    if (!hashMove && ply > 0 && depth >= kMinIirDepth) {
+        --depth;
+    }
+
+    const bool boundsAreMate = isMate(alpha) || isMate(beta);
+
+    constexpr int kMaxFutilityPruningDepth = 5;
+    const bool futilityPruningEnabled      = depth <= kMaxFutilityPruningDepth && !boundsAreMate;
+
+    constexpr int kMaxReverseFutilityPruningDepth = 5;
+    const bool reverseFutilityPruningEnabled =
+            !isPvNode && !isInCheck && depth <= kMaxReverseFutilityPruningDepth && !boundsAreMate;
+
+    // Reuse the static eval stored in the ttable, if available.
+    EvalT staticEval = ttHit ? ttHit->payload.staticEval : -kInfiniteEval;
+    if ((futilityPruningEnabled || reverseFutilityPruningEnabled) && staticEval == -kInfiniteEval) {
+        staticEval = evaluator_.evaluate(gameState, boardControl);
+    }
+    EvalT eval = staticEval;
+
+    // If we just did eval, we can now get the pin bit board for free.
+    const std::optional<BitBoard> enemyPinBitBoard =
+            gameState.getCalculatedPinBitBoard(nextSide(gameState.getSideToMove()));
+
+    std::optional<GameState::DirectCheckBitBoards> directCheckBitBoards = std::nullopt;
+
+    if (reverseFutilityPruningEnabled) {
+        static constexpr EvalT futilityMarginPerDepth = 140;
+        const int futilityValue                       = staticEval - futilityMarginPerDepth * depth;
+
+        if (futilityValue >= beta) {
+            // Return a conservative lower bound (fail-hard).
+            return beta;
+        }
+    }
+
+    if (ttHit) {
+        const auto& ttInfo = ttHit->payload;
+
         // Use TT value as a more accurate eval than static eval (for futility pruning)
         if (ttInfo.scoreType == ScoreType::Exact) {
             eval = ttInfo.score;
@@ -774,8 +1024,6 @@ EvalT MoveSearcher::Impl::search(
         } else if (ttInfo.scoreType == UpperBound) {
             eval = min(eval, ttInfo.score);
         }
-
-        hashMove = getTTableMove(ttInfo, gameState);
     }
 
     if (shouldProbeSyzygy(gameState, ply, depth)) {
@@ -819,7 +1067,7 @@ EvalT MoveSearcher::Impl::search(
         }
 
         if (nullMoveScore >= beta) {
-            storeNullMoveScoreInTTable(beta, depth, gameState.getBoardHash());
+            storeNullMoveScoreInTTable(beta, depth, gameState.getBoardHash(), staticEval);
 
             // Null move failed high, don't bother searching other moves.
             // Return a conservative lower bound (fail-hard).
@@ -867,7 +1115,8 @@ EvalT MoveSearcher::Impl::search(
                     bestMove,
                     depth,
                     gameState.getBoardHash(),
-                    isPvNode);
+                    isPvNode,
+                    staticEval);
 
             // Score was obtained from a subcall that failed high, so it was a lower bound for
             // that position. It is also a lower bound for the overall position because we're
@@ -876,24 +1125,111 @@ EvalT MoveSearcher::Impl::search(
         }
     }
 
-    auto moves = ply == 0 && rootMovesToSearch_ ? stack.makeStackVector(*rootMovesToSearch_)
-                                                : gameState.generateMoves(stack, boardControl);
-    if (moves.size() == 0) {
-        // Exact value
-        return evaluateNoLegalMoves(gameState);
-    }
+    // Moves are generated lazily by the move orderer, so we only find out whether there are any
+    // legal moves once it runs out.
+    bool hasLegalMoves = hashMove.has_value();
 
     auto moveOrderer = moveScorer_.getMoveOrderer(
-            std::move(moves), hashMove, gameState, boardControl, lastMove, ply);
+            stack,
+            hashMove,
+            ply == 0 ? rootMovesToSearch_ : nullptr,
+            gameState,
+            boardControl,
+            lastMove,
+            ply);
 
     int votesToSkipQuiets = 0;
 
+    // ABDADA: moves that another thread was already searching are deferred to the end.
+    std::vector<PendingMove> deferredMoves;
+    const bool canDeferMoves = activeMoves_ && depth >= ActiveMovesTable::kMinDepth;
+
+    // Root split: once the first move has been searched, the remaining root moves are searched by
+    // all threads. Below the minimum depth, the overhead isn't worth it.
+    static constexpr int kMinRootSplitDepth = 6;
+    const bool canSplitRoot = ply == 0 && smpMode_ == SmpMode::RootSplit
+                           && !helperThreads_.empty() && depth >= kMinRootSplitDepth;
+
+    const auto searchNonHashMove =
+            [&](const Move& move, const MoveType moveType, const int reduction) {
+                HashT moveHash = 0;
+                if (canDeferMoves) {
+                    moveHash = ActiveMovesTable::getMoveHash(gameState.getBoardHash(), move);
+                    activeMoves_->startSearching(moveHash);
+                }
+
+                const auto outcome = searchMove(
+                        gameState,
+                        move,
+                        moveType,
+                        depth,
+                        reduction,
+                        ply,
+                        alpha,
+                        beta,
+                        stack,
+                        bestScore,
+                        bestMove,
+                        lastMove,
+                        lastNullMovePly,
+                        /*useScoutSearch =*/isPvNode && (movesSearched > 0));
+
+                if (canDeferMoves) {
+                    activeMoves_->finishSearching(moveHash);
+                }
+
+                if (outcome != SearchMoveOutcome::Interrupted) {
+                    ++movesSearched;
+                }
+
+                return outcome;
+            };
+
+    bool stoppedEarly = false;
+
     while (const auto maybeMove = moveOrderer.getNextBestMove(gameState)) {
         const Move move = *maybeMove;
+        hasLegalMoves   = true;
 
         const int reduction = getDepthReduction(
                 move, movesSearched, moveOrderer.lastMoveWasLosing(), isPvNode, depth, extension);
 
+        if (canSplitRoot && movesSearched > 0) {
+            std::vector<PendingMove> splitMoves = {
+                    {.move      = move,
+                     .moveType  = moveOrderer.getLastMoveType(),
+                     .reduction = reduction}};
+
+            while (const auto maybeSplitMove = moveOrderer.getNextBestMove(gameState)) {
+                splitMoves.push_back(
+                        {.move      = *maybeSplitMove,
+                         .moveType  = moveOrderer.getLastMoveType(),
+                         .reduction = getDepthReduction(
+                                 *maybeSplitMove,
+                                 movesSearched + (int)splitMoves.size(),
+                                 moveOrderer.lastMoveWasLosing(),
+                                 isPvNode,
+                                 depth,
+                                 extension)});
+            }
+
+            (void)searchRootMovesInParallel(
+                    gameState,
+                    splitMoves,
+                    depth,
+                    alpha,
+                    beta,
+                    stack,
+                    bestScore,
+                    bestMove,
+                    movesSearched,
+                    lastNullMovePly,
+                    /*useScoutSearch =*/isPvNode);
+
+            stoppedEarly = true;
+            break;
+        }
+
         // Futility pruning
         if (futilityPruningEnabled) {
             const auto [futilityValue, voteToSkip] = getMoveFutilityValue(
@@ -926,31 +1262,41 @@ EvalT MoveSearcher::Impl::search(
             }
         }
 
-        const auto outcome = searchMove(
-                gameState,
-                move,
-                moveOrderer.getLastMoveType(),
-                depth,
-                reduction,
-                ply,
-                alpha,
-                beta,
-                stack,
-                bestScore,
-                bestMove,
-                lastMove,
-                lastNullMovePly,
-                /*useScoutSearch =*/isPvNode && (movesSearched > 0));
-
-        if (outcome != SearchMoveOutcome::Interrupted) {
-            ++movesSearched;
+        // Never defer the first move, so that every node makes progress.
+        if (canDeferMoves && movesSearched > 0
+            && activeMoves_->isBeingSearched(
+                    ActiveMovesTable::getMoveHash(gameState.getBoardHash(), move))) {
+            deferredMoves.push_back(
+                    {.move      = move,
+                     .moveType  = moveOrderer.getLastMoveType(),
+                     .reduction = reduction});
+            continue;
         }
 
+        const auto outcome = searchNonHashMove(move, moveOrderer.getLastMoveType(), reduction);
+
         if (outcome != SearchMoveOutcome::Continue) {
+            stoppedEarly = true;
             break;
         }
     }
 
+    if (!hasLegalMoves) {
+        // Exact value
+        return evaluateNoLegalMoves(gameState);
+    }
+
+    if (!stoppedEarly) {
+        for (const auto& deferredMove : deferredMoves) {
+            const auto outcome = searchNonHashMove(
+                    deferredMove.move, deferredMove.moveType, deferredMove.reduction);
+
+            if (outcome != SearchMoveOutcome::Continue) {
+                break;
+            }
+        }
+    }
+
     if (movesSearched > 0) {
         // If we fully evaluated any positions, update the ttable.
         MY_ASSERT(bestMove.pieceToMove != Piece::Invalid);
@@ -962,7 +1308,8 @@ EvalT MoveSearcher::Impl::search(
                 bestMove,
                 depth,
                 gameState.getBoardHash(),
-                isPvNode);
+                isPvNode,
+                staticEval);
     }
 
     // If bestScore <= alphaOrig, then all subcalls returned upper bounds and bestScore is the
@@ -1008,7 +1355,7 @@ EvalT MoveSearcher::Impl::quiesce(
         return bestScore;
     }
 
-    ++searchStatistics_.qNodesSearched;
+    incrementNodeCounter(qNodesSearched_);
 
     const bool isPvNode = beta - alpha > 1;
 
@@ -1016,7 +1363,7 @@ EvalT MoveSearcher::Impl::quiesce(
         searchStatistics_.selectiveDepth = max(searchStatistics_.selectiveDepth, ply);
     }
 
-    if (const auto endStateValue = checkForcedEndState(gameState, stack)) {
+    if (const auto endStateValue = checkForcedEndState(gameState, stack, evaluator_)) {
         return *endStateValue;
     }
 
@@ -1026,34 +1373,8 @@ EvalT MoveSearcher::Impl::quiesce(
     bool completedAnySearch = false;
     const EvalT alphaOrig   = alpha;
 
-    EvalT standPat = -kInfiniteEval;
-    if (!isInCheck) {
-        // Stand pat
-        standPat  = evaluator_.evaluate(gameState, boardControl);
-        bestScore = standPat;
-        if (bestScore >= beta) {
-            return bestScore;
-        }
-
-        static constexpr int kStandPatDeltaPruningThreshold = 1'000;
-        const EvalT deltaPruningScore = standPat + kStandPatDeltaPruningThreshold;
-        if (deltaPruningScore < alpha) {
-            // Stand pat is so far below alpha that we have no hope of raising it even if we find a
-            // good capture. Return the stand pat evaluation plus a large margin.
-            return deltaPruningScore;  // TODO: return alpha instead? (also in delta pruning below)
-        }
-
-        alpha = max(alpha, bestScore);
-    }
-    // If we just did eval, we can now get the pin bit board for free.
-    const std::optional<BitBoard> enemyPinBitBoard =
-            gameState.getCalculatedPinBitBoard(nextSide(gameState.getSideToMove()));
-
-    std::optional<std::array<BitBoard, kNumPieceTypes - 1>> directCheckBitBoards = std::nullopt;
-
-    std::optional<Move> hashMove = std::nullopt;
-
     // Probe the transposition table and use the stored score and/or move if we get a hit.
+    // This is done before the stand pat eval, so that we don't need to evaluate on a cutoff.
     auto ttHit = tTable_.probe(gameState.getBoardHash());
 
     if (rootInTb_ && ttHit.has_value() && ttHit->payload.scoreType == ScoreType::EGTB) {
@@ -1095,8 +1416,40 @@ EvalT MoveSearcher::Impl::quiesce(
             // So either way we return the tt entry score.
             return ttInfo.score;
         }
+    }
 
-        hashMove = getTTableMove(ttInfo, gameState);
+    EvalT standPat = -kInfiniteEval;
+    if (!isInCheck) {
+        // Stand pat. Reuse the static eval stored in the ttable, if available.
+        standPat = ttHit ? ttHit->payload.staticEval : -kInfiniteEval;
+        if (standPat == -kInfiniteEval) {
+            standPat = evaluator_.evaluate(gameState, boardControl);
+        }
+        bestScore = standPat;
+        if (bestScore >= beta) {
+            return bestScore;
+        }
+
+        static constexpr int kStandPatDeltaPruningThreshold = 1'000;
+        const EvalT deltaPruningScore = standPat + kStandPatDeltaPruningThreshold;
+        if (deltaPruningScore < alpha) {
+            // Stand pat is so far below alpha that we have no hope of raising it even if we find a
+            // good capture. Return the stand pat evaluation plus a large margin.
+            return deltaPruningScore;  // TODO: return alpha instead? (also in delta pruning below)
+        }
+
+        alpha = max(alpha, bestScore);
+    }
+    // If we just did eval, we can now get the pin bit board for free.
+    const std::optional<BitBoard> enemyPinBitBoard =
+            gameState.getCalculatedPinBitBoard(nextSide(gameState.getSideToMove()));
+
+    std::optional<std::array<BitBoard, kNumPieceTypes - 1>> directCheckBitBoards = std::nullopt;
+
+    std::optional<Move> hashMove = std::nullopt;
+
+    if (ttHit) {
+        hashMove = getTTableMove(ttHit->payload, gameState);
 
         bool shouldTryHashMove = hashMove.has_value();
         if (hashMove && !isInCheck) {
@@ -1164,7 +1517,8 @@ EvalT MoveSearcher::Impl::quiesce(
                         bestMove,
                         /*depth =*/0,
                         gameState.getBoardHash(),
-                        isPvNode);
+                        isPvNode,
+                        standPat);
 
                 return score;
             }
@@ -1277,7 +1631,8 @@ EvalT MoveSearcher::Impl::quiesce(
                 bestMove,
                 /*depth =*/0,
                 gameState.getBoardHash(),
-                isPvNode);
+                isPvNode,
+                standPat);
     }
 
     return bestScore;
@@ -1508,6 +1863,9 @@ RootSearchResult MoveSearcher::Impl::searchForBestMove(
     const auto reportCutoffStatistics =
 #ifdef TRACK_CUTOFF_STATISTICS
             [this]() {
+                if (!frontEnd_) {
+                    return;
+                }
                 std::stringstream ss;
                 moveScorer_.printCutoffStatistics(ss);
                 frontEnd_->reportDebugString(ss.str());
@@ -1546,6 +1904,18 @@ void MoveSearcher::Impl::prepareForNewSearch(
         const GameState& gameState,
         const std::vector<Move>* const movesToSearch,
         const bool tbHitAtRoot) {
+    waitUntilReady();
+
+    // Searches are started from the same thread every time, so binding it once would suffice. But
+    // binding is cheap compared to a search, and this way we don't need to track the thread.
+    if (bindToNumaNodes_) {
+        bindCurrentThreadToNumaNode(/*node*/ 0);
+        mainThreadIsBound_ = true;
+    } else if (mainThreadIsBound_) {
+        unbindCurrentThreadFromNumaNode();
+        mainThreadIsBound_ = false;
+    }
+
     // Set state variables to prepare for search.
     stopSearch_     = false;
     wasInterrupted_ = false;
@@ -1591,9 +1961,301 @@ void MoveSearcher::Impl::interruptSearch() {
     stopSearch_ = true;
 }
 
+void MoveSearcher::Impl::setNumThreads(const int numThreads) {
+    MY_ASSERT(numThreads >= 1 && numThreads <= kMaxThreads);
+
+    const int numHelpers = numThreads - 1;
+
+    while ((int)helperThreads_.size() > numHelpers) {
+        helperThreads_.pop_back();
+    }
+    while ((int)helperThreads_.size() < numHelpers) {
+        // Thread index 0 is the main thread, which is bound to node 0.
+        const int threadIdx = (int)helperThreads_.size() + 1;
+
+        std::optional<int> numaNode = std::nullopt;
+        if (bindToNumaNodes_) {
+            numaNode = threadIdx % getNumNumaNodes();
+        }
+
+        helperThreads_.push_back(std::make_unique<HelperThread>(evaluator_, tTable_, numaNode));
+    }
+}
+
+void MoveSearcher::Impl::setSmpMode(const SmpMode mode) {
+    smpMode_ = mode;
+
+    if (mode == SmpMode::Abdada) {
+        ownedActiveMoves_ = std::make_unique<ActiveMovesTable>();
+    } else {
+        ownedActiveMoves_.reset();
+    }
+    activeMoves_ = ownedActiveMoves_.get();
+}
+
+void MoveSearcher::Impl::setEvalHashTableSize(const int sizeInMb) {
+    // Resize the helpers' tables on their own threads, so that they're placed on the helper's NUMA
+    // node.
+    for (auto& helper : helperThreads_) {
+        helper->thread.start([&helper, sizeInMb]() {
+            helper->state->evaluator.setEvalHashTableSize(sizeInMb);
+        });
+    }
+    for (auto& helper : helperThreads_) {
+        helper->thread.wait();
+    }
+}
+
+void MoveSearcher::Impl::setNnueNetwork(const std::shared_ptr<const NnueNetwork>& network) {
+    // Setting the network clears the eval hash table, so like setEvalHashTableSize this is done on
+    // the helpers' own threads.
+    for (auto& helper : helperThreads_) {
+        helper->thread.start(
+                [&helper, &network]() { helper->state->evaluator.setNnueNetwork(network); });
+    }
+    for (auto& helper : helperThreads_) {
+        helper->thread.wait();
+    }
+
+    // The static evals stored in the transposition table are from the previous backend.
+    newGame();
+}
+
+void MoveSearcher::Impl::setNumaBinding(const bool enabled) {
+    bindToNumaNodes_ = enabled;
+
+    // Recreate the helper threads so that they (and their state) are placed accordingly.
+    const int numThreads = (int)helperThreads_.size() + 1;
+    helperThreads_.clear();
+    setNumThreads(numThreads);
+
+    if (frontEnd_ && enabled) {
+        const int numNodes = getNumNumaNodes();
+        if (numNodes > 1) {
+            frontEnd_->reportString(
+                    std::format("Binding search threads to {} NUMA nodes.", numNodes));
+        } else {
+            frontEnd_->reportString("Single NUMA node; search threads are not bound.");
+        }
+    }
+}
+
+void MoveSearcher::Impl::startHelperSearches(const GameState& gameState) {
+    for (int helperIdx = 0; helperIdx < (int)helperThreads_.size(); ++helperIdx) {
+        HelperThread& helper       = *helperThreads_[helperIdx];
+        HelperThread::State& state = *helper.state;
+        Impl& searcher             = state.searcher;
+
+        MY_ASSERT(!helper.thread.isBusy());
+
+        state.timeManager.configureForInfiniteSearch();
+
+        // Mirror the search configuration of the main searcher.
+        searcher.stopSearch_          = false;
+        searcher.wasInterrupted_      = false;
+        searcher.rootInTb_            = rootInTb_;
+        searcher.syzygyEnabled_       = syzygyEnabled_;
+        searcher.tTableTick_          = tTableTick_;
+        searcher.syzygyMinProbeDepth_ = syzygyMinProbeDepth_;
+        searcher.rootMovesToSearch_   = rootMovesToSearch_;
+        searcher.activeMoves_         = activeMoves_;
+
+        searcher.moveScorer_.prepareForNewSearch(gameState);
+        searcher.resetSearchStatistics();
+
+        if (smpMode_ == SmpMode::RootSplit) {
+            // Helpers wait for root moves to be handed out by the main thread.
+            continue;
+        }
+
+        // Thread index 0 is the main thread.
+        const int threadIdx = helperIdx + 1;
+
+        helper.thread.start([&state, gameState, threadIdx]() {
+            state.searcher.runHelperSearch(gameState, state.stack, threadIdx);
+        });
+    }
+}
+
+void MoveSearcher::Impl::stopHelperSearches() {
+    for (const auto& helper : helperThreads_) {
+        helper->state->searcher.interruptSearch();
+    }
+
+    for (const auto& helper : helperThreads_) {
+        helper->thread.wait();
+    }
+}
+
+void MoveSearcher::Impl::runHelperSearch(
+        GameState gameState, StackOfVectors<Move>& stack, const int threadIdx) {
+    // Skip some depths based on the thread index, so that the helper threads are spread out over
+    // different depths instead of all searching the same depth as the main thread.
+    static constexpr std::array<int, 20> kSkipSize = {
+            1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+    static constexpr std::array<int, 20> kSkipPhase = {
+            0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+    const int skipIdx = threadIdx % (int)kSkipSize.size();
+
+    // The game state was copied from the main thread; use this thread's evaluator's accumulator.
+    evaluator_.attachNnueAccumulator(gameState);
+
+    std::optional<EvalT> evalGuess = std::nullopt;
+
+    for (int depth = 1; depth <= kMaxDepth; ++depth) {
+        // With ABDADA, threads are kept apart by deferring moves instead.
+        const bool skipDepth = ((depth + kSkipPhase[skipIdx]) / kSkipSize[skipIdx]) % 2 != 0;
+        if (!activeMoves_ && skipDepth) {
+            continue;
+        }
+
+        const auto searchResult = searchForBestMove(gameState, depth, stack, evalGuess);
+
+        if (searchResult.wasInterrupted) {
+            break;
+        }
+
+        evalGuess = searchResult.eval;
+    }
+}
+
+MoveSearcher::Impl::SearchMoveOutcome MoveSearcher::Impl::searchRootMovesInParallel(
+        const GameState& gameState,
+        const std::vector<PendingMove>& moves,
+        const int depth,
+        EvalT& alpha,
+        const EvalT beta,
+        StackOfVectors<Move>& stack,
+        EvalT& bestScore,
+        Move& bestMove,
+        int& movesSearched,
+        const int lastNullMovePly,
+        const bool useScoutSearch) {
+    RootSplit split{
+            .moves           = moves,
+            .depth           = depth,
+            .beta            = beta,
+            .lastNullMovePly = lastNullMovePly,
+            .useScoutSearch  = useScoutSearch,
+            .alpha           = alpha,
+            .bestScore       = bestScore,
+            .bestMove        = bestMove};
+
+    for (const auto& helper : helperThreads_) {
+        Impl& searcher           = helper->state->searcher;
+        searcher.stopSearch_     = false;
+        searcher.wasInterrupted_ = false;
+
+        helper->thread.start([&split, &state = *helper->state, gameState]() {
+            state.searcher.searchRootSplitMoves(split, gameState, state.stack);
+        });
+    }
+
+    // The main thread searches moves too. It's the only thread that checks the time, so while
+    // waiting for the helpers it keeps checking and interrupts them when needed.
+    searchRootSplitMoves(split, gameState, stack);
+
+    static constexpr auto kPollInterval = std::chrono::milliseconds(1);
+    for (const auto& helper : helperThreads_) {
+        while (!helper->thread.waitFor(kPollInterval)) {
+            if (shouldStopSearch()) {
+                for (const auto& helperToStop : helperThreads_) {
+                    helperToStop->state->searcher.interruptSearch();
+                }
+            }
+        }
+    }
+
+    alpha     = split.alpha;
+    bestScore = split.bestScore;
+    bestMove  = split.bestMove;
+    movesSearched += split.movesSearched;
+
+    if (wasInterrupted_) {
+        return SearchMoveOutcome::Interrupted;
+    }
+    return bestScore >= beta ? SearchMoveOutcome::Cutoff : SearchMoveOutcome::Continue;
+}
+
+void MoveSearcher::Impl::searchRootSplitMoves(
+        RootSplit& split, GameState gameState, StackOfVectors<Move>& stack) {
+    evaluator_.attachNnueAccumulator(gameState);
+
+    while (true) {
+        const std::size_t moveIdx = split.nextMoveIdx.fetch_add(1, std::memory_order_relaxed);
+        if (moveIdx >= split.moves.size()) {
+            break;
+        }
+
+        EvalT alpha{};
+        {
+            std::lock_guard lock(split.mutex);
+            if (split.bestScore >= split.beta) {
+                // Another thread found a cutoff.
+                break;
+            }
+            alpha = split.alpha;
+        }
+
+        const PendingMove& pendingMove = split.moves[moveIdx];
+
+        EvalT moveScore = -kInfiniteEval;
+        Move move{};
+
+        const auto outcome = searchMove(
+                gameState,
+                pendingMove.move,
+                pendingMove.moveType,
+                split.depth,
+                pendingMove.reduction,
+                /*ply =*/0,
+                alpha,
+                split.beta,
+                stack,
+                moveScore,
+                move,
+                /*lastMove =*/{},
+                split.lastNullMovePly,
+                split.useScoutSearch);
+
+        if (outcome == SearchMoveOutcome::Interrupted) {
+            break;
+        }
+
+        std::lock_guard lock(split.mutex);
+        ++split.movesSearched;
+        if (moveScore > split.bestScore) {
+            split.bestScore = moveScore;
+            split.bestMove  = move;
+        }
+        split.alpha = max(split.alpha, moveScore);
+    }
+}
+
 SearchStatistics MoveSearcher::Impl::getSearchStatistics() const {
     SearchStatistics searchStatistics = searchStatistics_;
 
+    searchStatistics.normalNodesSearched = normalNodesSearched_.load(std::memory_order_relaxed);
+    searchStatistics.qNodesSearched      = qNodesSearched_.load(std::memory_order_relaxed);
+
+    const EvalHashStatistics evalHashStatistics = evaluator_.getEvalHashStatistics();
+    searchStatistics.evalHashProbes             = evalHashStatistics.probes;
+    searchStatistics.evalHashHits               = evalHashStatistics.hits;
+
+    // Include the nodes searched by the helper threads.
+    for (const auto& helper : helperThreads_) {
+        searchStatistics.normalNodesSearched +=
+                helper->state->searcher.normalNodesSearched_.load(std::memory_order_relaxed);
+        searchStatistics.qNodesSearched +=
+                helper->state->searcher.qNodesSearched_.load(std::memory_order_relaxed);
+
+        const EvalHashStatistics helperStatistics =
+                helper->state->evaluator.getEvalHashStatistics();
+        searchStatistics.evalHashProbes += helperStatistics.probes;
+        searchStatistics.evalHashHits += helperStatistics.hits;
+    }
+
     searchStatistics.ttableUtilization = tTable_.getUtilization();
     searchStatistics.timeElapsed       = timeManager_.getTimeElapsed();
 
@@ -1610,6 +2272,11 @@ SearchStatistics MoveSearcher::Impl::getSearchStatistics() const {
 void MoveSearcher::Impl::resetSearchStatistics() {
     searchStatistics_ = {};
 
+    normalNodesSearched_.store(0, std::memory_order_relaxed);
+    qNodesSearched_.store(0, std::memory_order_relaxed);
+
+    evaluator_.resetEvalHashStatistics();
+
     if (syzygyEnabled_) {
         searchStatistics_.tbHits = 0;
     }
@@ -1620,16 +2287,51 @@ int MoveSearcher::Impl::getDefaultTTableSizeInMb() const {
 }
 
 void MoveSearcher::Impl::setTTableSize(const int requestedSizeInMb) {
-    if (requestedSizeInMb == 0) {
-        tTable_ = SearchTTable();
-    } else {
-        const std::size_t tTableSizeInBytes   = (std::size_t)requestedSizeInMb * 1024 * 1024;
-        const std::size_t tTableSizeInEntries = tTableSizeInBytes / sizeof(SearchTTable::EntryT);
+    waitUntilReady();
+
+    // Free the old table first so that the old and new tables don't need to fit in memory at the
+    // same time.
+    tTable_ = SearchTTable();
+
+    if (requestedSizeInMb > 0) {
+        const std::size_t tTableSizeInBytes = (std::size_t)requestedSizeInMb * 1024 * 1024;
+        const std::size_t tTableSizeInBuckets =
+                tTableSizeInBytes / SearchTTable::kBucketSizeInBytes;
+
+        // Allocate and initialize in the background, so that the front end stays responsive. The
+        // next search (or 'isready') waits for the allocation to finish.
+        tTableTask_ = std::async(
+                std::launch::async,
+                [this, tTableSizeInBuckets, numThreads = getNumTTableThreads()]() {
+                    tTable_ = SearchTTable(tTableSizeInBuckets, numThreads);
+                });
+    }
+
+    reportTTableAllocation_ = frontEnd_ != nullptr;
+}
+
+void MoveSearcher::Impl::waitUntilReady() {
+    if (tTableTask_.valid()) {
+        tTableTask_.get();
+    }
+
+    if (reportTTableAllocation_) {
+        reportTTableAllocation_ = false;
 
-        tTable_ = SearchTTable(tTableSizeInEntries);
+        frontEnd_->reportString(std::format(
+                "Transposition table: {} MB allocated using {}.",
+                tTable_.getSizeInBytes() / (1024 * 1024),
+                pageTypeToString(tTable_.getPageType())));
     }
 }
 
+int MoveSearcher::Impl::getNumTTableThreads() const {
+    // Use all hardware threads, even if fewer search threads are configured: the table is usually
+    // resized before the number of search threads is set.
+    const int numHardwareThreads = (int)std::thread::hardware_concurrency();
+    return clamp(max(numHardwareThreads, (int)helperThreads_.size() + 1), 1, kMaxThreads);
+}
+
 std::optional<RootNodeInfo> MoveSearcher::Impl::getRootNodeInfo(const GameState& gameState) const {
     const HashT hash = gameState.getBoardHash();
     const auto ttHit = tTable_.probe(hash);
@@ -1687,6 +2389,14 @@ void MoveSearcher::interruptSearch() {
     impl_->interruptSearch();
 }
 
+void MoveSearcher::startHelperSearches(const GameState& gameState) {
+    impl_->startHelperSearches(gameState);
+}
+
+void MoveSearcher::stopHelperSearches() {
+    impl_->stopHelperSearches();
+}
+
 SearchStatistics MoveSearcher::getSearchStatistics() const {
     return impl_->getSearchStatistics();
 }
@@ -1703,6 +2413,18 @@ void MoveSearcher::setTTableSize(const int requestedSizeInMb) {
     impl_->setTTableSize(requestedSizeInMb);
 }
 
+void MoveSearcher::waitUntilReady() {
+    impl_->waitUntilReady();
+}
+
+void MoveSearcher::setEvalHashTableSize(const int sizeInMb) {
+    impl_->setEvalHashTableSize(sizeInMb);
+}
+
+void MoveSearcher::setNnueNetwork(std::shared_ptr<const NnueNetwork> network) {
+    impl_->setNnueNetwork(network);
+}
+
 std::optional<RootNodeInfo> MoveSearcher::getRootNodeInfo(const GameState& gameState) const {
     return impl_->getRootNodeInfo(gameState);
 }
@@ -24,7 +24,8 @@ struct RootNodeInfo {
 
 class MoveSearcher {
   public:
-    static constexpr int kMaxDepth = 100;
+    static constexpr int kMaxDepth   = 100;
+    static constexpr int kMaxThreads = 256;
 
     MoveSearcher(const TimeManager& timeManager, const Evaluator& evaluator);
     ~MoveSearcher();
@@ -56,7 +57,16 @@ class MoveSearcher {
     // Call this from a different thread to stop the search prematurely.
     void interruptSearch();
 
+    // Start the helper threads for multi-threaded search (Lazy SMP). The helpers share the
+    // transposition table and keep searching until stopHelperSearches() is called.
+    // Must be called after prepareForNewSearch.
+    void startHelperSearches(const GameState& gameState);
+
+    // Stop the helper threads and wait for them to finish.
+    void stopHelperSearches();
+
     // Get statistics since the last call to resetSearchStatistics.
+    // Node counts include the nodes searched by the helper threads.
     [[nodiscard]] SearchStatistics getSearchStatistics() const;
 
     // Reset the search statistics.
@@ -64,8 +74,22 @@ class MoveSearcher {
 
     [[nodiscard]] int getDefaultTTableSizeInMb() const;
 
+    // The table is (re)allocated in the background. Call waitUntilReady() to wait for it.
     void setTTableSize(int requestedSizeInMb);
 
+    // Wait for pending background work (resizing or clearing the transposition table) to complete.
+    void waitUntilReady();
+
+    // Resize the eval hash tables of the helper threads. The main thread's evaluator is owned by the
+    // caller and should be resized separately.
+    void setEvalHashTableSize(int sizeInMb);
+
+    // Set the NNUE network of the helper threads' evaluators (nullptr for the hand-crafted
+    // evaluation). The main thread's evaluator should be updated separately.
+    // This starts a new game, since the transposition table holds static evals from the previous
+    // backend.
+    void setNnueNetwork(std::shared_ptr<const NnueNetwork> network);
+
     [[nodiscard]] std::optional<RootNodeInfo> getRootNodeInfo(const GameState& gameState) const;
 
   private:
@@ -0,0 +1,321 @@
+#include "Nnue.h"
+
+#include "Math.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Read-only memory mapping of a file.
+class NnueNetwork::MappedFile {
+  public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        const HANDLE file = CreateFileA(
+                path.c_str(),
+                GENERIC_READ,
+                FILE_SHARE_READ,
+                nullptr,
+                OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL,
+                nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::invalid_argument("Failed to open NNUE file: " + path);
+        }
+
+        LARGE_INTEGER fileSize{};
+        GetFileSizeEx(file, &fileSize);
+        size_ = (std::size_t)fileSize.QuadPart;
+
+        mapping_ = size_ > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)
+                             : nullptr;
+        CloseHandle(file);
+        if (mapping_ == nullptr) {
+            throw std::invalid_argument("Failed to map NNUE file: " + path);
+        }
+
+        data_ = (const std::byte*)MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+        if (data_ == nullptr) {
+            CloseHandle(mapping_);
+            throw std::invalid_argument("Failed to map NNUE file: " + path);
+        }
+#else
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::invalid_argument("Failed to open NNUE file: " + path);
+        }
+
+        struct stat fileStat{};
+        if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+            close(fd);
+            throw std::invalid_argument("Failed to read NNUE file: " + path);
+        }
+        size_ = (std::size_t)fileStat.st_size;
+
+        void* const data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            throw std::invalid_argument("Failed to map NNUE file: " + path);
+        }
+        data_ = (const std::byte*)data;
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(mapping_);
+#else
+        munmap((void*)data_, size_);
+#endif
+    }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] const std::byte* data() const { return data_; }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+  private:
+    const std::byte* data_ = nullptr;
+    std::size_t size_      = 0;
+
+#ifdef _WIN32
+    HANDLE mapping_ = nullptr;
+#endif
+};
+
+namespace {
+
+constexpr int kNnueClippedMax = 127;
+
+constexpr int kNnueConcatenatedSize = 2 * kNnueHiddenSize;
+
+template <typename T>
+[[nodiscard]] const T* takeArray(const std::byte*& data, const std::size_t size) {
+    const T* const array = reinterpret_cast<const T*>(data);
+    data += sizeof(T) * size;
+    return array;
+}
+
+// Clip the accumulator of one perspective to [0, kNnueClippedMax] and convert to bytes.
+FORCE_INLINE void clippedRelu(
+        const NnueAccumulator::HiddenValues& values, std::uint8_t* const output) {
+#ifdef __AVX2__
+    constexpr int kChunkSize = 32;
+    const __m256i zero       = _mm256_setzero_si256();
+
+    for (int i = 0; i < kNnueHiddenSize; i += kChunkSize) {
+        const __m256i low  = _mm256_load_si256((const __m256i*)&values[i]);
+        const __m256i high = _mm256_load_si256((const __m256i*)&values[i + kChunkSize / 2]);
+
+        // Saturate to [-128, 127], then clip at 0. packs operates per 128-bit lane, so the 64-bit
+        // blocks need to be put back in order.
+        const __m256i packed  = _mm256_packs_epi16(low, high);
+        const __m256i clipped = _mm256_max_epi8(packed, zero);
+        const __m256i ordered = _mm256_permute4x64_epi64(clipped, 0b11'01'10'00);
+
+        _mm256_storeu_si256((__m256i*)&output[i], ordered);
+    }
+#else
+    for (int i = 0; i < kNnueHiddenSize; ++i) {
+        output[i] = (std::uint8_t)clamp((int)values[i], 0, kNnueClippedMax);
+    }
+#endif
+}
+
+// Dot product of unsigned inputs in [0, 127] with signed weights. size must be a multiple of 32.
+[[nodiscard]] FORCE_INLINE std::int32_t dotProduct(
+        const std::uint8_t* const input, const std::int8_t* const weights, const int size) {
+#ifdef __AVX2__
+    constexpr int kChunkSize = 32;
+    const __m256i ones       = _mm256_set1_epi16(1);
+
+    __m256i sum = _mm256_setzero_si256();
+    for (int i = 0; i < size; i += kChunkSize) {
+        const __m256i in = _mm256_loadu_si256((const __m256i*)&input[i]);
+        const __m256i w  = _mm256_loadu_si256((const __m256i*)&weights[i]);
+
+        // Pairwise products in int16 can't saturate: 2 * 127 * 128 < 2^15.
+        const __m256i products = _mm256_maddubs_epi16(in, w);
+        sum                    = _mm256_add_epi32(sum, _mm256_madd_epi16(products, ones));
+    }
+
+    const __m128i sum128 =
+            _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    const __m128i sum64 = _mm_add_epi32(sum128, _mm_unpackhi_epi64(sum128, sum128));
+    const __m128i sum32 = _mm_add_epi32(sum64, _mm_shuffle_epi32(sum64, 0b00'00'00'01));
+
+    return _mm_cvtsi128_si32(sum32);
+#else
+    std::int32_t sum = 0;
+    for (int i = 0; i < size; ++i) {
+        sum += (std::int32_t)input[i] * (std::int32_t)weights[i];
+    }
+    return sum;
+#endif
+}
+
+}  // namespace
+
+NnueNetwork::NnueNetwork(std::unique_ptr<MappedFile> file) : file_(std::move(file)) {
+    const std::byte* data = file_->data();
+
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(FileHeader));
+    data += sizeof(FileHeader);
+
+    constexpr std::size_t kNumFeatureWeights = (std::size_t)kNnueNumInputs * kNnueHiddenSize;
+    constexpr std::size_t kNumHiddenWeights  = (std::size_t)kNnueL2Size * kNnueConcatenatedSize;
+
+    featureWeights_ = takeArray<std::int16_t>(data, kNumFeatureWeights);
+    featureBiases_  = takeArray<std::int16_t>(data, kNnueHiddenSize);
+    hiddenWeights_  = takeArray<std::int8_t>(data, kNumHiddenWeights);
+    hiddenBiases_   = takeArray<std::int32_t>(data, kNnueL2Size);
+    outputWeights_  = takeArray<std::int8_t>(data, kNnueL2Size);
+
+    std::memcpy(&outputBias_, data, sizeof(std::int32_t));
+    outputScale_ = header.outputScale;
+}
+
+NnueNetwork::~NnueNetwork() = default;
+
+std::shared_ptr<const NnueNetwork> NnueNetwork::loadFromFile(const std::string& path) {
+    auto file = std::make_unique<MappedFile>(path);
+
+    FileHeader header;
+    if (file->size() < sizeof(FileHeader)) {
+        throw std::invalid_argument("NNUE file is too small: " + path);
+    }
+    std::memcpy(&header, file->data(), sizeof(FileHeader));
+
+    if (header.magic != FileHeader::kMagic || header.version != FileHeader::kVersion) {
+        throw std::invalid_argument("Not a supported NNUE file: " + path);
+    }
+
+    if (header.numInputs != kNnueNumInputs || header.hiddenSize != kNnueHiddenSize
+        || header.l2Size != kNnueL2Size || file->size() != kFileSize) {
+        throw std::invalid_argument("NNUE file has an unsupported architecture: " + path);
+    }
+
+    // Constructor is private, so we can't use make_shared.
+    return std::shared_ptr<const NnueNetwork>(new NnueNetwork(std::move(file)));
+}
+
+void NnueNetwork::refreshAccumulator(
+        NnueAccumulator& accumulator, const GameState& gameState) const {
+    refreshAccumulator(accumulator, Side::White, gameState);
+    refreshAccumulator(accumulator, Side::Black, gameState);
+}
+
+void NnueNetwork::refreshAccumulator(
+        NnueAccumulator& accumulator, const Side perspective, const GameState& gameState) const {
+    const BoardPosition kingPosition =
+            getFirstSetPosition(gameState.getPieceBitBoard(perspective, Piece::King));
+    const int kingBucket = getNnueKingBucket(perspective, kingPosition);
+
+    NnueAccumulator::HiddenValues& values = accumulator.values[(int)perspective];
+    std::memcpy(values.data(), featureBiases_, sizeof(values));
+    accumulator.kingBuckets[(int)perspective] = kingBucket;
+
+    // Add the pieces in batches, to amortize loading and storing the accumulator.
+    NnueFeatureChanges changes{};
+    for (const Side side : {Side::White, Side::Black}) {
+        for (int pieceIdx = 0; pieceIdx < kNumPieceTypes; ++pieceIdx) {
+            const Piece piece = (Piece)pieceIdx;
+
+            BitBoard pieceBitBoard = gameState.getPieceBitBoard(side, piece);
+            while (pieceBitBoard != BitBoard::Empty) {
+                const BoardPosition position = popFirstSetPosition(pieceBitBoard);
+                changes.add(getNnueFeatureIndex(perspective, kingBucket, side, piece, position));
+
+                if (changes.numAdded == NnueFeatureChanges::kMaxChanges) {
+                    updateAccumulator(values, changes);
+                    changes = {};
+                }
+            }
+        }
+    }
+
+    updateAccumulator(values, changes);
+}
+
+void NnueNetwork::updateAccumulator(
+        NnueAccumulator::HiddenValues& values, const NnueFeatureChanges& changes) const {
+    // Arithmetic wraps around on overflow, so unmaking a move by applying the reverse changes
+    // restores the accumulator exactly.
+#ifdef __AVX2__
+    constexpr int kChunkSize = 16;
+
+    for (int i = 0; i < kNnueHiddenSize; i += kChunkSize) {
+        __m256i sum = _mm256_load_si256((const __m256i*)&values[i]);
+
+        for (int j = 0; j < changes.numRemoved; ++j) {
+            const std::int16_t* const weights =
+                    &featureWeights_[(std::size_t)changes.removed[j] * kNnueHiddenSize];
+            sum = _mm256_sub_epi16(sum, _mm256_loadu_si256((const __m256i*)&weights[i]));
+        }
+        for (int j = 0; j < changes.numAdded; ++j) {
+            const std::int16_t* const weights =
+                    &featureWeights_[(std::size_t)changes.added[j] * kNnueHiddenSize];
+            sum = _mm256_add_epi16(sum, _mm256_loadu_si256((const __m256i*)&weights[i]));
+        }
+
+        _mm256_store_si256((__m256i*)&values[i], sum);
+    }
+#else
+    for (int j = 0; j < changes.numRemoved; ++j) {
+        const std::int16_t* const weights =
+                &featureWeights_[(std::size_t)changes.removed[j] * kNnueHiddenSize];
+        for (int i = 0; i < kNnueHiddenSize; ++i) {
+            values[i] = (std::int16_t)(values[i] - weights[i]);
+        }
+    }
+    for (int j = 0; j < changes.numAdded; ++j) {
+        const std::int16_t* const weights =
+                &featureWeights_[(std::size_t)changes.added[j] * kNnueHiddenSize];
+        for (int i = 0; i < kNnueHiddenSize; ++i) {
+            values[i] = (std::int16_t)(values[i] + weights[i]);
+        }
+    }
+#endif
+}
+
+int NnueNetwork::evaluate(const NnueAccumulator& accumulator, const Side sideToMove) const {
+    alignas(32) std::array<std::uint8_t, kNnueConcatenatedSize> transformed;
+    clippedRelu(accumulator.values[(int)sideToMove], &transformed[0]);
+    clippedRelu(accumulator.values[(int)nextSide(sideToMove)], &transformed[kNnueHiddenSize]);
+
+    alignas(32) std::array<std::uint8_t, kNnueL2Size> hidden;
+    for (int i = 0; i < kNnueL2Size; ++i) {
+        const std::int32_t sum =
+                hiddenBiases_[i]
+                + dotProduct(
+                        transformed.data(),
+                        &hiddenWeights_[(std::size_t)i * kNnueConcatenatedSize],
+                        kNnueConcatenatedSize);
+
+        hidden[i] = (std::uint8_t)clamp(sum >> kHiddenShift, 0, kNnueClippedMax);
+    }
+
+    const std::int32_t output =
+            outputBias_ + dotProduct(hidden.data(), outputWeights_, kNnueL2Size);
+
+    return (int)(((std::int64_t)output * outputScale_) >> 16);
+}
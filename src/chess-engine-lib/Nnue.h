@@ -0,0 +1,93 @@
+#pragma once
+
+#include "GameState.h"
+#include "NnueAccumulator.h"
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include <cstddef>
+#include <cstdint>
+
+// Size of the second hidden layer.
+inline constexpr int kNnueL2Size = 32;
+
+// A small efficiently updatable neural network for evaluation.
+//
+// Architecture: (kNnueNumInputs -> kNnueHiddenSize) x 2 perspectives -> kNnueL2Size -> 1.
+//
+// The feature transformer output (the accumulator) is clipped to [0, 127] and concatenated with the
+// side to move's perspective first. The hidden layer output is shifted right by kHiddenShift and
+// clipped to [0, 127]. The output layer is then scaled by outputScale / 2^16 to get the eval in
+// centipawns, from the perspective of the side to move.
+//
+// File format (little endian), see FileHeader for the header:
+//   header                                                    (64 bytes)
+//   feature weights  int16[kNnueNumInputs][kNnueHiddenSize]
+//   feature biases   int16[kNnueHiddenSize]
+//   hidden weights   int8[kNnueL2Size][2 * kNnueHiddenSize]
+//   hidden biases    int32[kNnueL2Size]
+//   output weights   int8[kNnueL2Size]
+//   output bias      int32
+class NnueNetwork {
+  public:
+    static constexpr int kHiddenShift = 6;
+
+    struct FileHeader {
+        static constexpr std::array<char, 8> kMagic  = {'E', 'U', 'W', 'E', 'N', 'N', 'U', 'E'};
+        static constexpr std::uint32_t kVersion      = 1;
+
+        std::array<char, 8> magic{};
+        std::uint32_t version    = 0;
+        std::uint32_t numInputs  = 0;
+        std::uint32_t hiddenSize = 0;
+        std::uint32_t l2Size     = 0;
+        std::int32_t outputScale = 0;
+
+        std::array<std::uint8_t, 36> padding{};
+    };
+    static_assert(sizeof(FileHeader) == 64);
+
+    static constexpr std::size_t kFileSize =
+            sizeof(FileHeader) + sizeof(std::int16_t) * kNnueNumInputs * kNnueHiddenSize
+            + sizeof(std::int16_t) * kNnueHiddenSize
+            + sizeof(std::int8_t) * kNnueL2Size * 2 * kNnueHiddenSize
+            + sizeof(std::int32_t) * kNnueL2Size + sizeof(std::int8_t) * kNnueL2Size
+            + sizeof(std::int32_t);
+
+    ~NnueNetwork();
+
+    NnueNetwork(const NnueNetwork&)            = delete;
+    NnueNetwork& operator=(const NnueNetwork&) = delete;
+
+    // Memory-map the network file at path. Throws std::invalid_argument if the file can't be read
+    // or isn't a valid network.
+    [[nodiscard]] static std::shared_ptr<const NnueNetwork> loadFromFile(const std::string& path);
+
+    // Compute the accumulator from scratch.
+    void refreshAccumulator(NnueAccumulator& accumulator, const GameState& gameState) const;
+    void refreshAccumulator(
+            NnueAccumulator& accumulator, Side perspective, const GameState& gameState) const;
+
+    void updateAccumulator(
+            NnueAccumulator::HiddenValues& values, const NnueFeatureChanges& changes) const;
+
+    // Evaluation from the perspective of sideToMove, in centipawns. Not clamped to the EvalT range.
+    [[nodiscard]] int evaluate(const NnueAccumulator& accumulator, Side sideToMove) const;
+
+  private:
+    class MappedFile;
+
+    explicit NnueNetwork(std::unique_ptr<MappedFile> file);
+
+    std::unique_ptr<MappedFile> file_;
+
+    const std::int16_t* featureWeights_ = nullptr;
+    const std::int16_t* featureBiases_  = nullptr;
+    const std::int8_t* hiddenWeights_   = nullptr;
+    const std::int32_t* hiddenBiases_   = nullptr;
+    const std::int8_t* outputWeights_   = nullptr;
+    std::int32_t outputBias_            = 0;
+    std::int32_t outputScale_           = 0;
+};
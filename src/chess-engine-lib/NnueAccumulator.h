@@ -0,0 +1,75 @@
+#pragma once
+
+#include "BoardConstants.h"
+#include "BoardPosition.h"
+#include "Macros.h"
+#include "Piece.h"
+#include "Side.h"
+
+#include <array>
+
+#include <cstdint>
+
+class NnueNetwork;
+
+// Input features of the NNUE evaluation: for each perspective (side), one feature for every
+// (king bucket, piece, square) combination. The position and the king bucket are relative to the
+// perspective, i.e., vertically reflected for black. Pieces are 'own' or 'enemy' relative to the
+// perspective, so both perspectives share the same weights.
+inline constexpr int kNnueNumKingBuckets   = 4;
+inline constexpr int kNnueNumPieceFeatures = kNumPieceTypes * kNumSides;
+inline constexpr int kNnueNumInputs        = kNnueNumKingBuckets * kNnueNumPieceFeatures * kSquares;
+
+// Size of the first hidden layer, per perspective.
+inline constexpr int kNnueHiddenSize = 256;
+
+[[nodiscard]] FORCE_INLINE constexpr BoardPosition getNnueRelativePosition(
+        const Side perspective, const BoardPosition position) {
+    return perspective == Side::White ? position : getVerticalReflection(position);
+}
+
+// King buckets: queen side or king side, and on the back two ranks or further forward.
+[[nodiscard]] FORCE_INLINE constexpr int getNnueKingBucket(
+        const Side perspective, const BoardPosition kingPosition) {
+    const auto [file, rank] =
+            fileRankFromPosition(getNnueRelativePosition(perspective, kingPosition));
+
+    return (file >= 4 ? 1 : 0) | (rank >= 2 ? 2 : 0);
+}
+
+[[nodiscard]] FORCE_INLINE constexpr int getNnueFeatureIndex(
+        const Side perspective,
+        const int kingBucket,
+        const Side pieceSide,
+        const Piece piece,
+        const BoardPosition position) {
+    const int pieceFeature = (pieceSide == perspective ? 0 : kNumPieceTypes) + (int)piece;
+    const BoardPosition relativePosition = getNnueRelativePosition(perspective, position);
+
+    return (kingBucket * kNnueNumPieceFeatures + pieceFeature) * kSquares + (int)relativePosition;
+}
+
+// Output of the (incrementally updated) feature transformer of an NNUE network, per perspective.
+struct NnueAccumulator {
+    using HiddenValues = std::array<std::int16_t, kNnueHiddenSize>;
+
+    alignas(32) std::array<HiddenValues, kNumSides> values{};
+
+    std::array<int, kNumSides> kingBuckets{};
+
+    bool operator==(const NnueAccumulator& other) const = default;
+};
+
+// A change of input features for one perspective. A move changes at most two features each way
+// (castling: king and rook; capture: moving piece and captured piece).
+struct NnueFeatureChanges {
+    static constexpr int kMaxChanges = 2;
+
+    std::array<int, kMaxChanges> removed{};
+    std::array<int, kMaxChanges> added{};
+    int numRemoved = 0;
+    int numAdded   = 0;
+
+    void remove(const int feature) { removed[numRemoved++] = feature; }
+    void add(const int feature) { added[numAdded++] = feature; }
+};
@@ -0,0 +1,204 @@
+#include "Numa.h"
+
+#include "MyAssert.h"
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+struct NumaNode {
+    int nodeIdx;
+    std::vector<int> cpus;
+};
+
+// Parse a list of the form "0-3,8,10-11" as used in sysfs.
+[[nodiscard]] std::vector<int> parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+
+    std::stringstream listStream(list);
+    std::string range;
+    while (std::getline(listStream, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+
+        const std::size_t dashPos = range.find('-');
+        const bool isRange        = dashPos != std::string::npos;
+
+        const int first = std::stoi(range.substr(0, dashPos));
+        const int last  = isRange ? std::stoi(range.substr(dashPos + 1)) : first;
+
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+
+    return cpus;
+}
+
+// Read the NUMA nodes from sysfs, restricted to the CPUs this process is allowed to run on. Nodes
+// without any such CPUs are skipped.
+[[nodiscard]] std::vector<NumaNode> readNumaNodes() {
+    std::vector<NumaNode> nodes;
+
+    cpu_set_t allowedCpus;
+    CPU_ZERO(&allowedCpus);
+    if (sched_getaffinity(0, sizeof(allowedCpus), &allowedCpus) != 0) {
+        return nodes;
+    }
+
+    std::ifstream onlineFile("/sys/devices/system/node/online");
+    std::string onlineList;
+    if (!std::getline(onlineFile, onlineList)) {
+        return nodes;
+    }
+
+    try {
+        for (const int nodeIdx : parseCpuList(onlineList)) {
+            std::ifstream cpuListFile(
+                    "/sys/devices/system/node/node" + std::to_string(nodeIdx) + "/cpulist");
+            std::string cpuList;
+            std::getline(cpuListFile, cpuList);
+
+            NumaNode node{.nodeIdx = nodeIdx, .cpus = {}};
+            for (const int cpu : parseCpuList(cpuList)) {
+                if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowedCpus)) {
+                    node.cpus.push_back(cpu);
+                }
+            }
+
+            if (!node.cpus.empty()) {
+                nodes.push_back(std::move(node));
+            }
+        }
+    } catch (const std::exception&) {
+        // Unexpected sysfs format; treat the machine as a single node.
+        nodes.clear();
+    }
+
+    return nodes;
+}
+
+[[nodiscard]] const std::vector<NumaNode>& getNumaNodes() {
+    static const std::vector<NumaNode> kNodes = readNumaNodes();
+    return kNodes;
+}
+
+// Node mask in the format expected by the memory policy system calls.
+struct NodeMask {
+    static constexpr int kMaxNodes    = 1024;
+    static constexpr int kBitsPerWord = 64;
+
+    std::uint64_t words[kMaxNodes / kBitsPerWord] = {};
+
+    void set(const int node) {
+        MY_ASSERT(node >= 0 && node < kMaxNodes);
+        words[node / kBitsPerWord] |= (std::uint64_t)1 << (node % kBitsPerWord);
+    }
+};
+
+}  // namespace
+
+int getNumNumaNodes() {
+    return std::max((int)getNumaNodes().size(), 1);
+}
+
+bool bindCurrentThreadToNumaNode(const int node) {
+    const auto& nodes = getNumaNodes();
+    if (nodes.size() <= 1) {
+        return false;
+    }
+
+    const NumaNode& numaNode = nodes[node % nodes.size()];
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (const int cpu : numaNode.cpus) {
+        CPU_SET(cpu, &cpus);
+    }
+    if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+        return false;
+    }
+
+    // Failing to set the memory policy is not fatal: the default policy allocates on the node of
+    // the thread that first touches the memory, which is now the bound node anyway.
+    NodeMask nodeMask;
+    nodeMask.set(numaNode.nodeIdx);
+    (void)syscall(SYS_set_mempolicy, MPOL_PREFERRED, nodeMask.words, NodeMask::kMaxNodes + 1);
+
+    return true;
+}
+
+void unbindCurrentThreadFromNumaNode() {
+    const auto& nodes = getNumaNodes();
+    if (nodes.size() <= 1) {
+        return;
+    }
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (const NumaNode& node : nodes) {
+        for (const int cpu : node.cpus) {
+            CPU_SET(cpu, &cpus);
+        }
+    }
+    (void)sched_setaffinity(0, sizeof(cpus), &cpus);
+
+    (void)syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0);
+}
+
+void interleaveMemoryOverNumaNodes(void* const data, const std::size_t sizeInBytes) {
+    const auto& nodes = getNumaNodes();
+    if (nodes.size() <= 1 || sizeInBytes == 0) {
+        return;
+    }
+
+    // mbind requires a page-aligned start address.
+    const std::size_t pageSize = (std::size_t)sysconf(_SC_PAGESIZE);
+    const std::uintptr_t start = (std::uintptr_t)data / pageSize * pageSize;
+    const std::uintptr_t end   = (std::uintptr_t)data + sizeInBytes;
+
+    NodeMask nodeMask;
+    for (const NumaNode& node : nodes) {
+        nodeMask.set(node.nodeIdx);
+    }
+
+    // Best effort: if this fails, the memory is simply placed according to the default policy.
+    (void)syscall(
+            SYS_mbind,
+            (void*)start,
+            end - start,
+            MPOL_INTERLEAVE,
+            nodeMask.words,
+            NodeMask::kMaxNodes + 1,
+            0);
+}
+
+#else
+
+int getNumNumaNodes() {
+    return 1;
+}
+
+bool bindCurrentThreadToNumaNode(int /*node*/) {
+    return false;
+}
+
+void unbindCurrentThreadFromNumaNode() {}
+
+void interleaveMemoryOverNumaNodes(void* /*data*/, std::size_t /*sizeInBytes*/) {}
+
+#endif
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+
+// Minimal NUMA support based on plain Linux APIs. On other platforms, or on machines with a single
+// NUMA node, the functions below are no-ops and the machine is treated as a single node.
+
+// Number of NUMA nodes that have CPUs available to this process. At least 1.
+[[nodiscard]] int getNumNumaNodes();
+
+// Bind the calling thread to the CPUs of the given NUMA node, and make it prefer allocating memory
+// on that node. Returns whether the thread was bound.
+bool bindCurrentThreadToNumaNode(int node);
+
+// Undo bindCurrentThreadToNumaNode: allow the calling thread to run on all available CPUs, and use
+// the default memory policy.
+void unbindCurrentThreadFromNumaNode();
+
+// Interleave the pages of the given memory range over all NUMA nodes. Only affects pages that
+// haven't been touched yet, so this should be called right after allocation.
+void interleaveMemoryOverNumaNodes(void* data, std::size_t sizeInBytes);
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Math.h"
+#include "MyAssert.h"
+
+#include <thread>
+#include <vector>
+
+#include <cstddef>
+
+// Split the range [0, size) into (at most) numThreads contiguous chunks and call func(begin, end)
+// for each chunk on its own thread. The calling thread processes the first chunk. Returns once all
+// chunks have been processed.
+template <typename FuncT>
+// NOLINTNEXTLINE(cppcoreguidelines-missing-std-forward), see https://joelfilho.com/blog/2020/forwarding_references/
+void parallelForChunks(const std::size_t size, const int numThreads, FuncT&& func) {
+    MY_ASSERT(numThreads >= 1);
+
+    const std::size_t numChunks = min((std::size_t)numThreads, max(size, (std::size_t)1));
+    const std::size_t chunkSize = (size + numChunks - 1) / numChunks;
+
+    std::vector<std::thread> threads;
+    threads.reserve(numChunks - 1);
+
+    for (std::size_t chunkIdx = 1; chunkIdx < numChunks; ++chunkIdx) {
+        const std::size_t begin = min(chunkIdx * chunkSize, size);
+        const std::size_t end   = min(begin + chunkSize, size);
+        threads.emplace_back([&func, begin, end]() { func(begin, end); });
+    }
+
+    func((std::size_t)0, min(chunkSize, size));
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
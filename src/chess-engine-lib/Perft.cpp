@@ -1,7 +1,35 @@
 #include "Perft.h"
 
+#include <atomic>
 #include <chrono>
+#include <fstream>
+#include <optional>
 #include <print>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Mix the depth into the hash, so that counts for different depths of the same position are
+// stored under different keys.
+[[nodiscard]] HashT getPerftHash(const GameState& gameState, const int depth) {
+    static constexpr HashT kDepthMultiplier = 0x9E37'79B9'7F4A'7C15ULL;
+    return gameState.getBoardHash() ^ ((HashT)depth * kDepthMultiplier);
+}
+
+[[nodiscard]] std::optional<PerftTTable> createPerftTTable(const int tTableSizeInMb) {
+    std::optional<PerftTTable> tTable;
+    if (tTableSizeInMb > 0) {
+        const std::size_t tTableSizeInBytes = (std::size_t)tTableSizeInMb * 1024 * 1024;
+        tTable.emplace(tTableSizeInBytes / sizeof(PerftTTable::EntryT));
+    }
+    return tTable;
+}
+
+using DoubleSecondsT = std::chrono::duration<double, std::ratio<1>>;
+
+}  // namespace
 
 std::size_t perft(const GameState& gameState, const int depth, StackOfVectors<Move>& stack) {
     if (depth == 0) {
@@ -45,6 +73,113 @@ std::size_t perftUnmake(GameState& gameState, const int depth, StackOfVectors<Mo
     return nodes;
 }
 
+std::size_t perftWithTTable(
+        GameState& gameState, const int depth, StackOfVectors<Move>& stack, PerftTTable& tTable) {
+    if (depth == 0) {
+        return 1;
+    }
+
+    const StackVector<Move> moves = gameState.generateMoves(stack);
+
+    if (depth == 1) {
+        return moves.size();
+    }
+
+    const HashT hash = getPerftHash(gameState, depth);
+    const auto ttHit = tTable.probe(hash);
+    if (ttHit && ttHit->payload.depth == (std::uint64_t)depth) {
+        return ttHit->payload.nodes;
+    }
+
+    std::size_t nodes = 0;
+    for (Move move : moves) {
+        auto unmakeInfo = gameState.makeMove(move);
+        nodes += perftWithTTable(gameState, depth - 1, stack, tTable);
+        gameState.unmakeMove(move, unmakeInfo);
+    }
+
+    tTable.store(
+            {.hash = hash, .payload = {.nodes = nodes, .depth = (std::uint64_t)depth}},
+            [](const PerftTTable::EntryT& newEntry, const PerftTTable::EntryT& oldEntry) {
+                // Prefer entries that save the most work.
+                return newEntry.payload.nodes >= oldEntry.payload.nodes;
+            });
+
+    return nodes;
+}
+
+std::size_t perftParallel(
+        const GameState& gameState,
+        const int depth,
+        const int numThreads,
+        PerftTTable* const tTable) {
+    MY_ASSERT(numThreads >= 1);
+
+    static constexpr std::size_t kMinSubtreesPerThread = 8;
+
+    if (depth <= 1) {
+        StackOfVectors<Move> stack;
+        return perft(gameState, depth, stack);
+    }
+
+    // Expand the tree breadth-first until there are enough subtrees to balance the work. Always
+    // leave at least 2 plies per subtree, so that it's worth handing out.
+    std::vector<GameState> subtrees = {gameState};
+    int subtreeDepth                = depth;
+    {
+        StackOfVectors<Move> stack;
+        while (subtrees.size() < kMinSubtreesPerThread * numThreads && subtreeDepth > 2) {
+            std::vector<GameState> children;
+            for (const GameState& subtree : subtrees) {
+                const StackVector<Move> moves = subtree.generateMoves(stack);
+                for (Move move : moves) {
+                    GameState& child = children.emplace_back(subtree);
+                    child.makeMove(move);
+                }
+            }
+
+            subtrees = std::move(children);
+            --subtreeDepth;
+        }
+    }
+
+    std::atomic<std::size_t> nextSubtree = 0;
+    std::atomic<std::size_t> totalNodes  = 0;
+
+    const auto worker = [&]() {
+        StackOfVectors<Move> stack;
+        stack.reserve(300);
+
+        std::size_t nodes = 0;
+        while (true) {
+            const std::size_t subtreeIdx = nextSubtree.fetch_add(1, std::memory_order_relaxed);
+            if (subtreeIdx >= subtrees.size()) {
+                break;
+            }
+
+            GameState& subtree = subtrees[subtreeIdx];
+            if (tTable) {
+                nodes += perftWithTTable(subtree, subtreeDepth, stack, *tTable);
+            } else {
+                nodes += perftUnmake(subtree, subtreeDepth, stack);
+            }
+        }
+
+        totalNodes.fetch_add(nodes, std::memory_order_relaxed);
+    };
+
+    std::vector<std::thread> threads;
+    for (int threadIdx = 1; threadIdx < numThreads; ++threadIdx) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return totalNodes;
+}
+
 std::size_t perftSplit(
         const GameState& gameState,
         const int depth,
@@ -91,8 +226,6 @@ void perftPrint(GameState& gameState, const int maxDepth, const bool useUnmake)
         }
         const auto endTime = std::chrono::high_resolution_clock::now();
 
-        using DoubleSecondsT = std::chrono::duration<double, std::ratio<1>>;
-
         const auto seconds =
                 std::chrono::duration_cast<DoubleSecondsT>(endTime - startTime).count();
         const double megaNps = (double)nodes / seconds / 1'000'000;
@@ -118,3 +251,97 @@ void perftSplitPrint(const GameState& gameState, const int depth, const int spli
     }
     std::println("{} total nodes", nodes);
 }
+
+void perftParallelPrint(
+        const GameState& gameState,
+        const int maxDepth,
+        const int numThreads,
+        const int tTableSizeInMb) {
+    std::optional<PerftTTable> tTable = createPerftTTable(tTableSizeInMb);
+
+    for (int depth = 1; depth <= maxDepth; ++depth) {
+        const auto startTime    = std::chrono::high_resolution_clock::now();
+        const std::size_t nodes = perftParallel(
+                gameState, depth, numThreads, tTable ? &tTable.value() : nullptr);
+        const auto endTime = std::chrono::high_resolution_clock::now();
+
+        const auto seconds =
+                std::chrono::duration_cast<DoubleSecondsT>(endTime - startTime).count();
+        const double megaNps = (double)nodes / seconds / 1'000'000;
+
+        std::print(
+                "Depth: {} - nodes: {:>13L} ({:>6.3f} s; {:>5.1f} Mn/s)\n",
+                depth,
+                nodes,
+                seconds,
+                megaNps);
+    }
+}
+
+bool perftSuitePrint(
+        const std::string& epdFilePath,
+        const int maxDepth,
+        const int numThreads,
+        const int tTableSizeInMb) {
+    std::ifstream epdFile(epdFilePath);
+    if (!epdFile) {
+        std::println("Failed to open EPD file '{}'.", epdFilePath);
+        return false;
+    }
+
+    // Counts are memoized across positions too; keys include the full position and the depth.
+    std::optional<PerftTTable> tTable = createPerftTTable(tTableSizeInMb);
+
+    int numPassed = 0;
+    int numFailed = 0;
+
+    const auto startTime = std::chrono::high_resolution_clock::now();
+
+    std::string line;
+    while (std::getline(epdFile, line)) {
+        const std::size_t fenEnd = line.find(';');
+        std::string fen          = line.substr(0, fenEnd);
+
+        const std::size_t lastFenChar = fen.find_last_not_of(" \t\r");
+        if (lastFenChar == std::string::npos) {
+            continue;
+        }
+        fen.resize(lastFenChar + 1);
+
+        const GameState gameState = GameState::fromFen(fen);
+
+        std::stringstream expectedStream(
+                fenEnd == std::string::npos ? std::string() : line.substr(fenEnd));
+        std::string depthToken;
+        std::size_t expectedNodes{};
+        while (expectedStream >> depthToken >> expectedNodes) {
+            // depthToken has the form ';D<depth>'.
+            const int depth = std::stoi(depthToken.substr(2));
+            if (depth > maxDepth) {
+                continue;
+            }
+
+            const std::size_t nodes = perftParallel(
+                    gameState, depth, numThreads, tTable ? &tTable.value() : nullptr);
+
+            if (nodes == expectedNodes) {
+                ++numPassed;
+            } else {
+                ++numFailed;
+                std::println(
+                        "FAILED: {} depth {}: expected {} nodes, got {}.",
+                        fen,
+                        depth,
+                        expectedNodes,
+                        nodes);
+            }
+        }
+    }
+
+    const auto endTime = std::chrono::high_resolution_clock::now();
+    const auto seconds = std::chrono::duration_cast<DoubleSecondsT>(endTime - startTime).count();
+
+    std::println("{} passed, {} failed ({:.3f} s)", numPassed, numFailed, seconds);
+
+    return numFailed == 0;
+}
@@ -1,13 +1,34 @@
 #pragma once
 
 #include "GameState.h"
+#include "TTable.h"
 
 #include <map>
+#include <string>
+
+// Memoized subtree count for perft. Packed into 64 bits so that the table is lock-free and can be
+// shared between threads.
+struct PerftPayload {
+    std::uint64_t nodes : 56 = 0;
+    std::uint64_t depth : 8  = 0;
+};
+
+using PerftTTable = TTable<PerftPayload>;
 
 std::size_t perft(const GameState& gameState, int depth, StackOfVectors<Move>& stack);
 
 std::size_t perftUnmake(GameState& gameState, int depth, StackOfVectors<Move>& stack);
 
+// Like perftUnmake, but subtree counts are memoized in tTable, keyed by board hash and depth.
+std::size_t perftWithTTable(
+        GameState& gameState, int depth, StackOfVectors<Move>& stack, PerftTTable& tTable);
+
+// Perft split over numThreads threads. The tree is expanded until there are enough subtrees to
+// balance the work, and the subtrees are then handed out to the threads one at a time. Each thread
+// has its own stack. If tTable is not null, it's shared by all threads to memoize subtree counts.
+std::size_t perftParallel(
+        const GameState& gameState, int depth, int numThreads, PerftTTable* tTable = nullptr);
+
 std::size_t perftSplit(
         const GameState& gameState,
         int depth,
@@ -19,3 +40,13 @@ std::size_t perftSplit(
 void perftPrint(GameState& gameState, int maxDepth, bool useUnmake = false);
 
 void perftSplitPrint(const GameState& gameState, int depth, int splitDepth);
+
+// If tTableSizeInMb is 0, no transposition table is used.
+void perftParallelPrint(
+        const GameState& gameState, int maxDepth, int numThreads, int tTableSizeInMb = 0);
+
+// Run the perft positions in an EPD file and compare against the expected node counts. Each line
+// has the form '<fen> ;D1 <nodes> ;D2 <nodes> ...'. Depths beyond maxDepth are skipped.
+// Returns true if all node counts matched.
+bool perftSuitePrint(
+        const std::string& epdFilePath, int maxDepth, int numThreads, int tTableSizeInMb = 0);
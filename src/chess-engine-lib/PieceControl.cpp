@@ -5,8 +5,11 @@
 #include "Macros.h"
 
 #include <array>
+#include <string_view>
 #include <utility>
 
+#include <cstring>
+
 namespace {
 
 constexpr BitBoard computeKnightControlledSquares(const BoardPosition origin) {
@@ -516,14 +519,240 @@ int calculatePackedBishopXRays() {
     return entriesCalculated;
 }
 
-const int dummyRookAttacks = calculatePackedRookAttacks();
-const int dummyRookXRays   = calculatePackedRookXRays();
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+bool gPackedAttacksCalculated = false;
+
+void calculatePackedAttacks() {
+    if (gPackedAttacksCalculated) {
+        return;
+    }
+
+    calculatePackedRookAttacks();
+    calculatePackedRookXRays();
+    calculatePackedBishopAttacks();
+    calculatePackedBishopXRays();
+
+    gPackedAttacksCalculated = true;
+}
+
+template <int NumEntries>
+struct UnpackedAttacks {
+    std::array<std::uint64_t, NumEntries> attacks;
+    std::array<const std::uint64_t*, kSquares> entries;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+UnpackedAttacks<kNumRookAttackEntries> gUnpackedRookAttacks;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+UnpackedAttacks<kNumRookAttackEntries> gUnpackedRookXRays;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+UnpackedAttacks<kNumBishopAttackEntries> gUnpackedBishopAttacks;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+UnpackedAttacks<kNumBishopAttackEntries> gUnpackedBishopXRays;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+bool gUnpackedAttacksCalculated = false;
+
+// Same layout as the packed table, so the same PEXT index can be used.
+template <typename PackedAttacksT, int NumEntries>
+void unpackAttacks(
+        const PackedAttacksT& packedAttacks,
+        const std::array<std::uint64_t, kSquares>& lookupExtractMasks,
+        UnpackedAttacks<NumEntries>& unpackedAttacks) {
+    for (int square = 0; square < kSquares; ++square) {
+        const std::ptrdiff_t offset = packedAttacks.entries[square] - packedAttacks.attacks.data();
+        const int numLookUpEntries  = 1 << std::popcount(lookupExtractMasks[square]);
+
+        MY_ASSERT(offset + numLookUpEntries <= NumEntries);
+        unpackedAttacks.entries[square] = &unpackedAttacks.attacks[offset];
+
+        for (int i = 0; i < numLookUpEntries; ++i) {
+            unpackedAttacks.attacks[offset + i] = pdep(
+                    (std::uint64_t)packedAttacks.attacks[offset + i],
+                    packedAttacks.depositMasks[square]);
+        }
+    }
+}
+
+void calculateUnpackedAttacks() {
+    if (gUnpackedAttacksCalculated) {
+        return;
+    }
+
+    // The unpacked tables are built from the packed ones, which also provide the extract masks.
+    calculatePackedAttacks();
+
+    unpackAttacks(gPackedRookAttacks, gRookLookupExtractMasks, gUnpackedRookAttacks);
+    unpackAttacks(gPackedRookXRays, gRookLookupExtractMasks, gUnpackedRookXRays);
+    unpackAttacks(gPackedBishopAttacks, gBishopLookupExtractMasks, gUnpackedBishopAttacks);
+    unpackAttacks(gPackedBishopXRays, gBishopLookupExtractMasks, gUnpackedBishopXRays);
+
+    gUnpackedAttacksCalculated = true;
+}
+
+// Magics that index both the attack and the x-ray table of a square without destructive
+// collisions. Found offline with a sparse random search.
+constexpr std::array<std::uint64_t, kSquares> kRookMagics = {
+        0x1080004008801020ULL, 0x0840092002c03000ULL, 0x1900200010400900ULL, 0x0880100008000480ULL,
+        0x4200100420080200ULL, 0x8100020100080400ULL, 0x0200040110886200ULL, 0x0200008040220411ULL,
+        0x0404800084400220ULL, 0x0000401000402000ULL, 0x0086001081220440ULL, 0x0408800800100280ULL,
+        0x000a001201040820ULL, 0x8848800200840080ULL, 0x4001000100040200ULL, 0x0442000102105084ULL,
+        0x9080010020804100ULL, 0x0040404000201009ULL, 0x0000808010002009ULL, 0x2200090021d00100ULL,
+        0x0008008008040080ULL, 0x0004004002010040ULL, 0x0011040008015042ULL, 0x00000a0001768104ULL,
+        0x0000800080204009ULL, 0x2010004140002001ULL, 0x9800200280100080ULL, 0x1000100080080080ULL,
+        0x0442000a00049020ULL, 0x2100040080020080ULL, 0x0800120400900148ULL, 0x0010040a00128541ULL,
+        0x2800804000800030ULL, 0x1010002000400041ULL, 0x4000200011004100ULL, 0x0610008410800800ULL,
+        0x0400802402800800ULL, 0xc100020080800400ULL, 0x0002000802000401ULL, 0x0182085882000401ULL,
+        0x0220204000808000ULL, 0x2860100040024022ULL, 0x0001002004110040ULL, 0x99101042000a0020ULL,
+        0x0004080004008080ULL, 0x0010040002008080ULL, 0x2012004881020004ULL, 0x8300842444820011ULL,
+        0x0088403882010200ULL, 0x0820400080210100ULL, 0x0110910040a00300ULL, 0x0801100280080480ULL,
+        0x0242009008200600ULL, 0x1002000489500200ULL, 0x0040800200010080ULL, 0x0091800041000080ULL,
+        0x0000209300488001ULL, 0x04c1002414824001ULL, 0x020020000b001041ULL, 0x7000100004200901ULL,
+        0x8002002004100802ULL, 0x30010002084c0007ULL, 0x0888221800813004ULL, 0x4000002840840112ULL,
+};
+
+constexpr std::array<std::uint64_t, kSquares> kBishopMagics = {
+        0x10102002004a1420ULL, 0x8020040400584008ULL, 0x10510800811201c8ULL, 0x5204042080000088ULL,
+        0x2204106880000002ULL, 0x1401042004000000ULL, 0x0400880410042004ULL, 0x0028208200a02020ULL,
+        0x1500241990010e00ULL, 0x8001200182020a40ULL, 0x40004101030b0000ULL, 0x8002041042000100ULL,
+        0x4010011041020038ULL, 0x0000010421044000ULL, 0x1500210808020a00ULL, 0x8000088400880520ULL,
+        0x0405004010040100ULL, 0x1005823210040108ULL, 0x2708008102040011ULL, 0x4048200404009100ULL,
+        0x0018104101400024ULL, 0x0003000601190101ULL, 0x8004803108491000ULL, 0x8014241200820800ULL,
+        0x0006e080100c3040ULL, 0x0501044a11041800ULL, 0x9020300008004045ULL, 0x0894080000220040ULL,
+        0x1001010083104000ULL, 0x5004030040900080ULL, 0x000400422c012400ULL, 0x0002128698404812ULL,
+        0x1010108404900440ULL, 0x0928021182084100ULL, 0x2006080409020024ULL, 0x1010202020180080ULL,
+        0xa010008200202200ULL, 0x2098015100019004ULL, 0x0002041440810811ULL, 0x802a02020000b098ULL,
+        0x0009015090004060ULL, 0x4000821082081001ULL, 0x0100210040420800ULL, 0x0800004010488a00ULL,
+        0x2000081104004040ULL, 0x4c8e029015000082ULL, 0x0420340322224842ULL, 0x1298260043400210ULL,
+        0x0000822802400008ULL, 0x00008a0101600000ULL, 0x3040003412080021ULL, 0x3040290220884800ULL,
+        0x4a1500401041004aULL, 0x8010200282020781ULL, 0x0020203142209091ULL, 0x0070300600902110ULL,
+        0x0040808800b62048ULL, 0x0000810400c44420ULL, 0x00080400440c0441ULL, 0x8340080020840411ULL,
+        0x0000000104208200ULL, 0x0000800810d00080ULL, 0x0400530411080200ULL, 0x4040702400932244ULL,
+};
+
+struct MagicEntry {
+    std::uint64_t lookUpMask;
+    std::uint64_t magic;
+    const std::uint64_t* attacks;
+    int shift;
+};
+
+template <int NumEntries>
+struct MagicAttacks {
+    std::array<std::uint64_t, NumEntries> attacks;
+    std::array<MagicEntry, kSquares> entries;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+MagicAttacks<kNumRookAttackEntries> gMagicRookAttacks;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+MagicAttacks<kNumRookAttackEntries> gMagicRookXRays;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+MagicAttacks<kNumBishopAttackEntries> gMagicBishopAttacks;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+MagicAttacks<kNumBishopAttackEntries> gMagicBishopXRays;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+bool gMagicAttacksCalculated = false;
+
+constexpr std::array<std::pair<int, int>, 4> kRookDirections = {
+        std::pair{0, 1}, std::pair{1, 0}, std::pair{0, -1}, std::pair{-1, 0}};
+constexpr std::array<std::pair<int, int>, 4> kBishopDirections = {
+        std::pair{1, 1}, std::pair{1, -1}, std::pair{-1, -1}, std::pair{-1, 1}};
+
+template <int NumEntries>
+void calculateMagicAttacks(
+        MagicAttacks<NumEntries>& magicAttacks,
+        const std::array<std::uint64_t, kSquares>& magics,
+        const std::array<std::pair<int, int>, 4>& directions,
+        BitBoard (*computeAttacks)(BoardPosition, BitBoard)) {
+    int entriesCalculated = 0;
+
+    for (int square = 0; square < kSquares; ++square) {
+        const BoardPosition position = (BoardPosition)square;
+        const auto [file, rank]      = fileRankFromPosition(position);
+
+        std::uint64_t fullSight = 0;
+        for (const auto& [fileIncrement, rankIncrement] : directions) {
+            fullSight |= getFullRay(position, fileIncrement, rankIncrement);
+        }
+
+        std::uint64_t lookUpMask = fullSight & ~(1ULL << square);
+        if (file > 0) {
+            lookUpMask &= kNotWestFileMask;
+        }
+        if (file < 7) {
+            lookUpMask &= kNotEastFileMask;
+        }
+        if (rank > 0) {
+            lookUpMask &= kNotSouthRankMask;
+        }
+        if (rank < 7) {
+            lookUpMask &= kNotNorthRankMask;
+        }
+
+        const int numLookUpEntries = 1 << std::popcount(lookUpMask);
+        const int shift            = kSquares - std::popcount(lookUpMask);
+
+        MY_ASSERT(entriesCalculated + numLookUpEntries <= NumEntries);
+        std::uint64_t* attacks = &magicAttacks.attacks[entriesCalculated];
+
+        // Enumerate all subsets of the look up mask (Carry-Rippler).
+        std::uint64_t occupancy = 0;
+        do {
+            const std::uint64_t lookUpIndex = (occupancy * magics[square]) >> shift;
+            const BitBoard attack           = computeAttacks(position, (BitBoard)occupancy);
+
+            // Collisions are only allowed between occupancies with the same attack.
+            MY_ASSERT(attacks[lookUpIndex] == 0 || attacks[lookUpIndex] == (std::uint64_t)attack);
+            attacks[lookUpIndex] = (std::uint64_t)attack;
+
+            occupancy = (occupancy - lookUpMask) & lookUpMask;
+        } while (occupancy != 0);
+
+        magicAttacks.entries[square] = {
+                .lookUpMask = lookUpMask,
+                .magic      = magics[square],
+                .attacks    = attacks,
+                .shift      = shift,
+        };
+        entriesCalculated += numLookUpEntries;
+    }
+
+    MY_ASSERT(entriesCalculated == NumEntries);
+}
+
+void calculateMagicAttacks() {
+    if (gMagicAttacksCalculated) {
+        return;
+    }
+
+    calculateMagicAttacks(
+            gMagicRookAttacks, kRookMagics, kRookDirections, computeRookControlledSquares);
+    calculateMagicAttacks(gMagicRookXRays, kRookMagics, kRookDirections, computeRookXRaySquares);
+    calculateMagicAttacks(
+            gMagicBishopAttacks,
+            kBishopMagics,
+            kBishopDirections,
+            computeBishopControlledSquares);
+    calculateMagicAttacks(
+            gMagicBishopXRays, kBishopMagics, kBishopDirections, computeBishopXRaySquares);
+
+    gMagicAttacksCalculated = true;
+}
 
-const int dummyBishopAttacks = calculatePackedBishopAttacks();
-const int dummyBishopXRays   = calculatePackedBishopXRays();
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+SliderAttackBackend gSliderAttackBackend = SliderAttackBackend::PextPacked;
+
+const int dummySliderAttackBackend = []() {
+    setSliderAttackBackend(getPreferredSliderAttackBackend());
+    return 0;
+}();
 
 template <typename PackedAttacksT>
-FORCE_INLINE BitBoard getSliderAttack(
+FORCE_INLINE BitBoard getPackedPextSliderAttack(
         const BoardPosition position,
         const BitBoard occupancy,
         const PackedAttacksT& packedAttacks,
@@ -534,8 +763,93 @@ FORCE_INLINE BitBoard getSliderAttack(
     return (BitBoard)pdep((std::uint64_t)packedAttack, packedAttacks.depositMasks[(int)position]);
 }
 
+template <int NumEntries>
+FORCE_INLINE BitBoard getUnpackedPextSliderAttack(
+        const BoardPosition position,
+        const BitBoard occupancy,
+        const UnpackedAttacks<NumEntries>& unpackedAttacks,
+        const std::array<std::uint64_t, kSquares>& lookupExtractMasks) {
+    const std::uint64_t lookUpIndex =
+            pext((std::uint64_t)occupancy, lookupExtractMasks[(int)position]);
+    return (BitBoard)unpackedAttacks.entries[(int)position][lookUpIndex];
+}
+
+template <int NumEntries>
+FORCE_INLINE BitBoard getMagicSliderAttack(
+        const BoardPosition position,
+        const BitBoard occupancy,
+        const MagicAttacks<NumEntries>& magicAttacks) {
+    const MagicEntry& entry = magicAttacks.entries[(int)position];
+    const std::uint64_t lookUpIndex =
+            (((std::uint64_t)occupancy & entry.lookUpMask) * entry.magic) >> entry.shift;
+    return (BitBoard)entry.attacks[lookUpIndex];
+}
+
 }  // namespace
 
+SliderAttackBackend getPreferredSliderAttackBackend() {
+    const auto [maxLeaf, vendorEbx, vendorEcx, vendorEdx] = cpuid(0);
+
+    std::array<char, 12> vendor{};
+    std::memcpy(vendor.data(), &vendorEbx, 4);
+    std::memcpy(vendor.data() + 4, &vendorEdx, 4);
+    std::memcpy(vendor.data() + 8, &vendorEcx, 4);
+
+    if (std::string_view(vendor.data(), vendor.size()) != "AuthenticAMD" || maxLeaf < 1) {
+        return SliderAttackBackend::PextPacked;
+    }
+
+    const std::uint32_t signature  = cpuid(1)[0];
+    const std::uint32_t baseFamily = (signature >> 8) & 0xf;
+    const std::uint32_t family =
+            baseFamily == 0xf ? baseFamily + ((signature >> 20) & 0xff) : baseFamily;
+
+    // Zen 3 is family 19h. Earlier families implement PEXT and PDEP in microcode.
+    constexpr std::uint32_t kZen3Family = 0x19;
+    return family < kZen3Family ? SliderAttackBackend::Magic : SliderAttackBackend::PextPacked;
+}
+
+SliderAttackBackend getSliderAttackBackend() {
+    return gSliderAttackBackend;
+}
+
+void setSliderAttackBackend(const SliderAttackBackend backend) {
+    switch (backend) {
+        case SliderAttackBackend::PextPacked:
+            calculatePackedAttacks();
+            break;
+        case SliderAttackBackend::PextUnpacked:
+            calculateUnpackedAttacks();
+            break;
+        case SliderAttackBackend::Magic:
+            calculateMagicAttacks();
+            break;
+        default:
+            UNREACHABLE;
+    }
+    gSliderAttackBackend = backend;
+}
+
+std::size_t getSliderAttackTableSizeInBytes(const SliderAttackBackend backend) {
+    const std::size_t extractMasksSize =
+            sizeof(gRookLookupExtractMasks) + sizeof(gBishopLookupExtractMasks);
+
+    switch (backend) {
+        case SliderAttackBackend::PextPacked:
+            return sizeof(gPackedRookAttacks) + sizeof(gPackedRookXRays)
+                 + sizeof(gPackedBishopAttacks) + sizeof(gPackedBishopXRays) + extractMasksSize;
+        case SliderAttackBackend::PextUnpacked:
+            return sizeof(gUnpackedRookAttacks) + sizeof(gUnpackedRookXRays)
+                 + sizeof(gUnpackedBishopAttacks) + sizeof(gUnpackedBishopXRays)
+                 + extractMasksSize;
+        case SliderAttackBackend::Magic:
+            return sizeof(gMagicRookAttacks) + sizeof(gMagicRookXRays)
+                 + sizeof(gMagicBishopAttacks) + sizeof(gMagicBishopXRays);
+        default:
+            UNREACHABLE;
+    }
+}
+
 FORCE_INLINE BitBoard getPawnControlledSquares(const BoardPosition position, const Side side) {
     return getPawnControlledSquares(BitBoard::Empty | position, side);
 }
@@ -561,19 +875,63 @@ BitBoard getKingControlledSquares(const BoardPosition position) {
 }
 
 FORCE_INLINE BitBoard getRookAttack(const BoardPosition position, const BitBoard occupancy) {
-    return getSliderAttack(position, occupancy, gPackedRookAttacks, gRookLookupExtractMasks);
+    switch (gSliderAttackBackend) {
+        case SliderAttackBackend::PextPacked:
+            return getPackedPextSliderAttack(
+                    position, occupancy, gPackedRookAttacks, gRookLookupExtractMasks);
+        case SliderAttackBackend::PextUnpacked:
+            return getUnpackedPextSliderAttack(
+                    position, occupancy, gUnpackedRookAttacks, gRookLookupExtractMasks);
+        case SliderAttackBackend::Magic:
+            return getMagicSliderAttack(position, occupancy, gMagicRookAttacks);
+        default:
+            UNREACHABLE;
+    }
 }
 
 FORCE_INLINE BitBoard getRookXRay(const BoardPosition position, const BitBoard occupancy) {
-    return getSliderAttack(position, occupancy, gPackedRookXRays, gRookLookupExtractMasks);
+    switch (gSliderAttackBackend) {
+        case SliderAttackBackend::PextPacked:
+            return getPackedPextSliderAttack(
+                    position, occupancy, gPackedRookXRays, gRookLookupExtractMasks);
+        case SliderAttackBackend::PextUnpacked:
+            return getUnpackedPextSliderAttack(
+                    position, occupancy, gUnpackedRookXRays, gRookLookupExtractMasks);
+        case SliderAttackBackend::Magic:
+            return getMagicSliderAttack(position, occupancy, gMagicRookXRays);
+        default:
+            UNREACHABLE;
+    }
 }
 
 FORCE_INLINE BitBoard getBishopAttack(const BoardPosition position, const BitBoard occupancy) {
-    return getSliderAttack(position, occupancy, gPackedBishopAttacks, gBishopLookupExtractMasks);
+    switch (gSliderAttackBackend) {
+        case SliderAttackBackend::PextPacked:
+            return getPackedPextSliderAttack(
+                    position, occupancy, gPackedBishopAttacks, gBishopLookupExtractMasks);
+        case SliderAttackBackend::PextUnpacked:
+            return getUnpackedPextSliderAttack(
+                    position, occupancy, gUnpackedBishopAttacks, gBishopLookupExtractMasks);
+        case SliderAttackBackend::Magic:
+            return getMagicSliderAttack(position, occupancy, gMagicBishopAttacks);
+        default:
+            UNREACHABLE;
+    }
 }
 
 FORCE_INLINE BitBoard getBishopXRay(const BoardPosition position, const BitBoard occupancy) {
-    return getSliderAttack(position, occupancy, gPackedBishopXRays, gBishopLookupExtractMasks);
+    switch (gSliderAttackBackend) {
+        case SliderAttackBackend::PextPacked:
+            return getPackedPextSliderAttack(
+                    position, occupancy, gPackedBishopXRays, gBishopLookupExtractMasks);
+        case SliderAttackBackend::PextUnpacked:
+            return getUnpackedPextSliderAttack(
+                    position, occupancy, gUnpackedBishopXRays, gBishopLookupExtractMasks);
+        case SliderAttackBackend::Magic:
+            return getMagicSliderAttack(position, occupancy, gMagicBishopXRays);
+        default:
+            UNREACHABLE;
+    }
 }
 
 FORCE_INLINE std::uint64_t getFullRay(
@@ -5,11 +5,37 @@
 #include "Piece.h"
 #include "Side.h"
 
+#include <cstddef>
+
 BitBoard getPawnControlledSquares(BitBoard pawnBitBoard, Side side);
 BitBoard getPawnControlledSquares(BoardPosition position, Side side);
 
 BitBoard getKingControlledSquares(BoardPosition position);
 
+// How slider attacks and x-rays are looked up.
+enum class SliderAttackBackend {
+    // PEXT to index the tables, PDEP to unpack the 16-bit entries.
+    PextPacked,
+    // PEXT to index the tables, which store full 64-bit attack sets. Avoids the PDEP at the cost
+    // of tables four times as large. Run the 'sliderbench' command to compare the backends.
+    PextUnpacked,
+    // Fancy magic bitboards. PEXT and PDEP are microcoded on AMD CPUs before Zen 3, which makes the
+    // PEXT backend several times slower there.
+    Magic,
+};
+
+// The backend best suited to the CPU we're running on. It's selected on startup.
+SliderAttackBackend getPreferredSliderAttackBackend();
+
+SliderAttackBackend getSliderAttackBackend();
+
+// Calculates the tables for the backend if needed. Not thread-safe: no attacks may be looked up
+// concurrently.
+void setSliderAttackBackend(SliderAttackBackend backend);
+
+// Total size of the slider attack and x-ray tables used by the backend.
+std::size_t getSliderAttackTableSizeInBytes(SliderAttackBackend backend);
+
 BitBoard getRookAttack(BoardPosition position, BitBoard occupancy);
 BitBoard getRookXRay(BoardPosition position, BitBoard occupancy);
 BitBoard getBishopAttack(BoardPosition position, BitBoard occupancy);
@@ -12,6 +12,8 @@ struct SearchStatistics {
     float ttableUtilization           = 0.0f;
     int selectiveDepth                = 0;
     std::optional<int> tbHits         = std::nullopt;
+    std::uint64_t evalHashProbes      = 0;
+    std::uint64_t evalHashHits        = 0;
 
     std::chrono::milliseconds timeElapsed{};
     float nodesPerSecond = 0.0f;
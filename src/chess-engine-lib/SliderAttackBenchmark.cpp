@@ -0,0 +1,151 @@
+#include "SliderAttackBenchmark.h"
+
+#include "GameState.h"
+#include "Perft.h"
+#include "PieceControl.h"
+
+#include <array>
+#include <chrono>
+#include <print>
+#include <utility>
+#include <vector>
+
+#include <cstdint>
+
+namespace {
+
+using DoubleSecondsT = std::chrono::duration<double, std::ratio<1>>;
+
+constexpr int kNumLookups     = 1 << 14;
+constexpr int kNumRepetitions = 256;
+
+struct Lookup {
+    BoardPosition position;
+    std::uint64_t occupancy;
+};
+
+// Random squares and occupancies. Squares are occupied with probability 1/4, which is roughly the
+// density of a middlegame position. Seeded with a constant so that runs are comparable.
+std::vector<Lookup> generateLookups() {
+    std::uint64_t state = 0x9E37'79B9'7F4A'7C15ULL;
+
+    auto next = [&]() {
+        // xorshift64*
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545'F491'4F6C'DD1DULL;
+    };
+
+    std::vector<Lookup> lookups;
+    lookups.reserve(kNumLookups);
+    for (int i = 0; i < kNumLookups; ++i) {
+        const auto position = (BoardPosition)(next() % kSquares);
+        lookups.push_back({.position = position, .occupancy = next() & next()});
+    }
+    return lookups;
+}
+
+// Lookups don't depend on each other, so they can overlap: measures throughput.
+// Returns millions of lookups per second.
+double measureIndependentLookups(const std::vector<Lookup>& lookups, std::uint64_t& checksum) {
+    const auto startTime = std::chrono::high_resolution_clock::now();
+    for (int repetition = 0; repetition < kNumRepetitions; ++repetition) {
+        for (const auto& [position, occupancy] : lookups) {
+            checksum ^= (std::uint64_t)getRookAttack(position, (BitBoard)occupancy);
+            checksum ^= (std::uint64_t)getBishopAttack(position, (BitBoard)occupancy);
+        }
+    }
+    const auto endTime = std::chrono::high_resolution_clock::now();
+
+    const auto seconds = std::chrono::duration_cast<DoubleSecondsT>(endTime - startTime).count();
+    return 2.0 * kNumLookups * kNumRepetitions / seconds / 1'000'000;
+}
+
+// Each lookup's occupancy depends on the previous result: measures latency.
+// Returns millions of lookups per second.
+double measureDependentLookups(const std::vector<Lookup>& lookups, std::uint64_t& checksum) {
+    std::uint64_t previous = 0;
+
+    const auto startTime = std::chrono::high_resolution_clock::now();
+    for (int repetition = 0; repetition < kNumRepetitions; ++repetition) {
+        for (const auto& [position, occupancy] : lookups) {
+            // Toggling the occupancy of a1 based on the previous result serializes the lookups.
+            previous = (std::uint64_t)getRookAttack(
+                    position, (BitBoard)(occupancy ^ (previous & 1)));
+            previous ^= (std::uint64_t)getBishopAttack(
+                    position, (BitBoard)(occupancy ^ (previous & 1)));
+        }
+    }
+    const auto endTime = std::chrono::high_resolution_clock::now();
+
+    checksum ^= previous;
+
+    const auto seconds = std::chrono::duration_cast<DoubleSecondsT>(endTime - startTime).count();
+    return 2.0 * kNumLookups * kNumRepetitions / seconds / 1'000'000;
+}
+
+// Returns millions of nodes per second.
+double measurePerft() {
+    StackOfVectors<Move> stack;
+    stack.reserve(300);
+
+    const std::array<std::pair<GameState, int>, 2> positions = {
+            std::pair{GameState::startingPosition(), 5},
+            std::pair{
+                    GameState::fromFen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/"
+                                       "R3K2R w KQkq - 0 1"),
+                    4},
+    };
+
+    std::size_t nodes{};
+    const auto startTime = std::chrono::high_resolution_clock::now();
+    for (auto [gameState, depth] : positions) {
+        nodes += perftUnmake(gameState, depth, stack);
+    }
+    const auto endTime = std::chrono::high_resolution_clock::now();
+
+    const auto seconds = std::chrono::duration_cast<DoubleSecondsT>(endTime - startTime).count();
+    return (double)nodes / seconds / 1'000'000;
+}
+
+}  // namespace
+
+void sliderAttackBenchmarkPrint() {
+    const SliderAttackBackend originalBackend = getSliderAttackBackend();
+
+    constexpr std::array<std::pair<SliderAttackBackend, const char*>, 3> kBackends = {
+            std::pair{SliderAttackBackend::PextPacked, "pext-packed"},
+            std::pair{SliderAttackBackend::PextUnpacked, "pext-unpacked"},
+            std::pair{SliderAttackBackend::Magic, "magic"},
+    };
+
+    const std::vector<Lookup> lookups = generateLookups();
+
+    // Printed so that the lookups can't be optimized away.
+    std::uint64_t checksum = 0;
+
+    for (const auto& [backend, name] : kBackends) {
+        setSliderAttackBackend(backend);
+
+        // Warm up the caches.
+        (void)measureIndependentLookups(lookups, checksum);
+
+        const double independentLookups = measureIndependentLookups(lookups, checksum);
+        const double dependentLookups   = measureDependentLookups(lookups, checksum);
+        const double perftMegaNps       = measurePerft();
+
+        std::println(
+                "{:<13} - tables: {:>5} KiB; independent lookups: {:>6.1f} M/s; dependent "
+                "lookups: {:>6.1f} M/s; perft: {:>5.1f} Mn/s",
+                name,
+                getSliderAttackTableSizeInBytes(backend) / 1024,
+                independentLookups,
+                dependentLookups,
+                perftMegaNps);
+    }
+
+    std::println("Checksum: {:016x}", checksum);
+
+    setSliderAttackBackend(originalBackend);
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+// Compare the slider attack backends: table size, throughput of independent lookups, latency of
+// dependent lookups, and perft speed. Each backend's tables are calculated on first use; the
+// selected backend is restored afterwards.
+void sliderAttackBenchmarkPrint();
@@ -3,12 +3,16 @@
 #include "BoardHash.h"
 #include "EvalT.h"
 #include "Intrinsics.h"
+#include "LargePages.h"
 #include "Move.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <bit>
-#include <memory>
+#include <limits>
 #include <optional>
+#include <type_traits>
 
 #include <cstdint>
 
@@ -26,6 +30,8 @@ struct TTEntry {
     PayloadT payload = {};
 };
 
+// Note: when stored in the SearchTTable, only the promotion piece of moveFlags is retained. The
+// other flags can be derived from the position.
 struct SearchTTPayload {
     EvalT score            = 0;
     std::uint8_t depth     = 0;
@@ -34,15 +40,27 @@ struct SearchTTPayload {
     BoardPosition moveFrom = (BoardPosition)0;
     BoardPosition moveTo   = (BoardPosition)0;
     MoveFlags moveFlags    = MoveFlags::None;
+    // Static evaluation of the position, or -kInfiniteEval if it wasn't computed.
+    EvalT staticEval = -kInfiniteEval;
 };
 
 using SearchTTEntry = TTEntry<SearchTTPayload>;
 
+// Transposition table with two entries per index: a 'valuable' and a 'recent' entry.
+//
+// If the payload fits in a 64-bit word, the table is lock-free and can be shared between threads.
+// Each entry is then stored as two 64-bit words: the payload and the hash XOR-ed with the payload.
+// When probing, the hash is recovered by XOR-ing the two words. If another thread was writing the
+// entry concurrently, the recovered hash will not match, so torn entries are rejected. (See Hyatt
+// & Mann, "A lock-less transposition table implementation for parallel search chess engines".)
 template <typename PayloadT>
 class TTable {
   public:
     using EntryT = TTEntry<PayloadT>;
 
+    static constexpr bool kIsLockless =
+            sizeof(PayloadT) == sizeof(std::uint64_t) && std::is_trivially_copyable_v<PayloadT>;
+
     // Construct table with minimal size.
     TTable();
 
@@ -60,23 +78,142 @@ class TTable {
     // Returns true if an entry was erased.
     bool erase(HashT hash);
 
-    [[nodiscard]] int getNumInUse() const { return numInUse_; }
-    [[nodiscard]] float getUtilization() const { return static_cast<float>(numInUse_) / size_; }
+    // Estimate the fraction of entries in use by sampling the start of the table.
+    [[nodiscard]] float getUtilization() const;
 
   private:
+    struct LocklessSlot {
+        std::atomic<std::uint64_t> hashXorPayload = 0;
+        std::atomic<std::uint64_t> payload        = 0;
+    };
+
+    using SlotT = std::conditional_t<kIsLockless, LocklessSlot, EntryT>;
+
     [[nodiscard]] std::size_t computeIndex(HashT hash) const;
 
-    // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
-    std::unique_ptr<EntryT[]> data_;
+    [[nodiscard]] EntryT loadEntry(std::size_t index) const;
+
+    void storeEntry(std::size_t index, const EntryT& entry);
+
+    LargePageArray<SlotT> data_;
     std::size_t size_;
     std::size_t mask_;
 
-    int numInUse_ = 0;
-
     static constexpr std::size_t kMinimumSize = 2;
+
+    static constexpr std::size_t kUtilizationSampleSize = 1000;
 };
 
-using SearchTTable = TTable<SearchTTPayload>;
+// Transposition table for the search, organized in cache-line-sized buckets of compressed entries.
+//
+// Each entry consists of a 64-bit data word and a 32-bit check word, so that a bucket holds five
+// entries:
+//  - The data word holds the packed payload (score, 16-bit move, depth, score type, tick and static
+//    eval). The remaining high bits hold the hash bits just below bit 32.
+//  - The check word holds bits 32-63 of the hash XOR-ed with both halves of the data word.
+// Together with the bucket index (the lowest bits of the hash), this verifies most of the hash. As
+// in TTable's lockless mode, the XOR makes entries torn by concurrent writes fail verification, so
+// the table can be shared between threads.
+//
+// Probes and stores touch only a single cache line. Within a bucket, new entries replace the entry
+// with the lowest depth, where depth is reduced by the age of the entry.
+//
+// Each bucket also records the epoch in which it was last written. Incrementing the table's epoch
+// clears the table in constant time: buckets from an older epoch are treated as empty.
+class SearchTTable {
+  public:
+    using EntryT = SearchTTEntry;
+
+    static constexpr std::size_t kBucketSizeInBytes = 64;
+    static constexpr int kEntriesPerBucket          = 5;
+
+    // Construct table with minimal size.
+    SearchTTable();
+
+    // Allocating and initializing the table is split over numThreads threads.
+    explicit SearchTTable(std::size_t requestedNumBuckets, int numThreads = 1);
+
+    // Number of distinct ticks that can be stored in an entry.
+    static constexpr int kNumTicks = 64;
+
+    // Ticks are stored with a limited number of bits, so they wrap around. Returns the age of an
+    // entry with tick entryTick, relative to currentTick, in the range [0, kNumTicks).
+    [[nodiscard]] static int computeAge(std::uint8_t currentTick, std::uint8_t entryTick);
+
+    // Zero the table, split over numThreads threads.
+    void clear(int numThreads = 1);
+
+    // Clear the table in constant time by starting a new epoch. Buckets are only zeroed when they
+    // are first written to in the new epoch. Must not be called while other threads access the
+    // table.
+    void clearLazily();
+
+    [[nodiscard]] std::optional<EntryT> probe(HashT hash) const;
+
+    void prefetch(HashT hash) const;
+
+    template <typename FuncT>
+    void store(const EntryT& entry, FuncT&& isMoreValuable);
+
+    // Returns true if an entry was erased.
+    bool erase(HashT hash);
+
+    // Estimate the fraction of entries in use by sampling the start of the table.
+    [[nodiscard]] float getUtilization() const;
+
+    [[nodiscard]] std::size_t getSizeInBytes() const { return numBuckets_ * sizeof(Bucket); }
+
+    [[nodiscard]] PageType getPageType() const { return buckets_.getPageType(); }
+
+  private:
+    struct alignas(kBucketSizeInBytes) Bucket {
+        std::array<std::atomic<std::uint64_t>, kEntriesPerBucket> data   = {};
+        std::array<std::atomic<std::uint32_t>, kEntriesPerBucket> checks = {};
+        std::atomic<std::uint32_t> epoch                                 = 0;
+    };
+    static_assert(sizeof(Bucket) == kBucketSizeInBytes);
+
+    static constexpr int kScoreShift     = 0;
+    static constexpr int kMoveFromShift  = 16;
+    static constexpr int kMoveToShift    = 22;
+    static constexpr int kPromotionShift = 28;
+    static constexpr int kDepthShift     = 31;
+    static constexpr int kScoreTypeShift = 38;
+    static constexpr int kTickShift       = 41;
+    static constexpr int kStaticEvalShift = 47;
+    static constexpr int kKeyShift        = 63;
+
+    static constexpr std::uint64_t kMaxDepth = (1 << (kScoreTypeShift - kDepthShift)) - 1;
+    static constexpr std::uint64_t kTickMask = kNumTicks - 1;
+    static_assert(kTickShift + std::bit_width(kTickMask) <= kStaticEvalShift);
+    static_assert(kStaticEvalShift + 16 <= kKeyShift);
+
+    // The key holds the hash bits just below the ones verified by the check word.
+    static constexpr int kNumKeyBits        = 64 - kKeyShift;
+    static constexpr int kKeyHashShift      = 32 - kNumKeyBits;
+    static constexpr std::uint64_t kKeyMask = (1ULL << kNumKeyBits) - 1;
+
+    [[nodiscard]] static std::uint64_t encodeData(const EntryT& entry);
+    [[nodiscard]] static SearchTTPayload decodePayload(std::uint64_t data);
+
+    [[nodiscard]] static std::uint32_t computeCheck(HashT hash, std::uint64_t data);
+
+    [[nodiscard]] static bool matches(HashT hash, std::uint64_t data, std::uint32_t check);
+
+    [[nodiscard]] std::size_t computeIndex(HashT hash) const;
+
+    [[nodiscard]] bool isCurrentEpoch(const Bucket& bucket) const;
+
+    void storeInSlot(Bucket& bucket, int slot, std::uint64_t data, std::uint32_t check);
+
+    LargePageArray<Bucket> buckets_;
+    std::size_t numBuckets_;
+    std::size_t mask_;
+
+    std::uint32_t epoch_ = 0;
+
+    static constexpr std::size_t kUtilizationSampleSize = 200;
+};
 
 template <typename PayloadT>
 TTable<PayloadT>::TTable() : TTable(kMinimumSize) {}
@@ -85,8 +222,7 @@ template <typename PayloadT>
 TTable<PayloadT>::TTable(const std::size_t requestedSize) : size_(std::bit_floor(requestedSize)) {
     MY_ASSERT(size_ >= 2);
 
-    // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
-    data_ = std::make_unique<EntryT[]>(size_);
+    data_ = LargePageArray<SlotT>(size_);
 
     // size_ is a power of 2, so size_ - 1 is all 1s in binary.
     // size_ - 2 is all 1s except the least significant bit.
@@ -97,8 +233,13 @@ TTable<PayloadT>::TTable(const std::size_t requestedSize) : size_(std::bit_floor
 
 template <typename PayloadT>
 void TTable<PayloadT>::clear() {
-    std::fill_n(data_.get(), size_, EntryT{});
-    numInUse_ = 0;
+    if constexpr (kIsLockless) {
+        for (std::size_t index = 0; index < size_; ++index) {
+            storeEntry(index, EntryT{});
+        }
+    } else {
+        std::fill_n(data_.get(), size_, EntryT{});
+    }
 }
 
 template <typename PayloadT>
@@ -107,12 +248,12 @@ std::optional<TTEntry<PayloadT>> TTable<PayloadT>::probe(const HashT hash) const
     const std::size_t valuableIndex = index;
     const std::size_t recentIndex   = index | 1;
 
-    const EntryT& recentEntry = data_[recentIndex];
+    const EntryT recentEntry = loadEntry(recentIndex);
     if (recentEntry.hash == hash) {
         return recentEntry;
     }
 
-    const EntryT& valuableEntry = data_[valuableIndex];
+    const EntryT valuableEntry = loadEntry(valuableIndex);
     if (valuableEntry.hash == hash) {
         return valuableEntry;
     }
@@ -128,20 +269,20 @@ void TTable<PayloadT>::store(const TTEntry<PayloadT>& entryToStore, FuncT&& isMo
     const std::size_t valuableIndex = index;
     const std::size_t recentIndex   = index | 1;
 
-    EntryT& valuableEntry = data_[valuableIndex];
-    EntryT& recentEntry   = data_[recentIndex];
+    // In lockless mode, other threads may modify the entries between loading and storing. In that
+    // case we may lose an entry, but we never store a corrupted one.
+    const EntryT valuableEntry = loadEntry(valuableIndex);
 
     // First check if valuableEntry is unused.
     if (valuableEntry.hash == 0) {
-        valuableEntry = entryToStore;
-        ++numInUse_;
+        storeEntry(valuableIndex, entryToStore);
         // We stored the entry, no need to continue.
         return;
     }
     if (valuableEntry.hash == entryToStore.hash) {
         // Same position, update if more valuable
         if (isMoreValuable(entryToStore, valuableEntry)) {
-            valuableEntry = entryToStore;
+            storeEntry(valuableIndex, entryToStore);
         }
         // We either stored the entry or found that we already have more valuable information for
         // this position. Either way, no need to continue.
@@ -151,17 +292,11 @@ void TTable<PayloadT>::store(const TTEntry<PayloadT>& entryToStore, FuncT&& isMo
     if (isMoreValuable(entryToStore, valuableEntry)) {
         // New position is more valuable. Move the old valuable entry to the recent entry slot and
         // store the new entry in the valuable entry slot.
-        if (recentEntry.hash == 0) {
-            ++numInUse_;
-        }
-        recentEntry   = valuableEntry;
-        valuableEntry = entryToStore;
+        storeEntry(recentIndex, valuableEntry);
+        storeEntry(valuableIndex, entryToStore);
     } else {
         // New position is less valuable. Store the new entry in the recent entry slot.
-        if (recentEntry.hash == 0) {
-            ++numInUse_;
-        }
-        recentEntry = entryToStore;
+        storeEntry(recentIndex, entryToStore);
     }
 }
 
@@ -171,20 +306,15 @@ FORCE_INLINE bool TTable<PayloadT>::erase(const HashT hash) {
     const std::size_t valuableIndex = index;
     const std::size_t recentIndex   = index | 1;
 
-    EntryT& valuableEntry = data_[valuableIndex];
-    EntryT& recentEntry   = data_[recentIndex];
-
-    if (valuableEntry.hash == hash) {
-        valuableEntry = recentEntry;
-        recentEntry   = {};
-        --numInUse_;
+    if (loadEntry(valuableIndex).hash == hash) {
+        storeEntry(valuableIndex, loadEntry(recentIndex));
+        storeEntry(recentIndex, EntryT{});
 
         return true;
     }
 
-    if (recentEntry.hash == hash) {
-        recentEntry = {};
-        --numInUse_;
+    if (loadEntry(recentIndex).hash == hash) {
+        storeEntry(recentIndex, EntryT{});
 
         return true;
     }
@@ -192,6 +322,20 @@ FORCE_INLINE bool TTable<PayloadT>::erase(const HashT hash) {
     return false;
 }
 
+template <typename PayloadT>
+float TTable<PayloadT>::getUtilization() const {
+    const std::size_t numSamples = std::min(size_, kUtilizationSampleSize);
+
+    std::size_t numInUse = 0;
+    for (std::size_t index = 0; index < numSamples; ++index) {
+        if (loadEntry(index).hash != 0) {
+            ++numInUse;
+        }
+    }
+
+    return static_cast<float>(numInUse) / static_cast<float>(numSamples);
+}
+
 template <typename PayloadT>
 FORCE_INLINE void TTable<PayloadT>::prefetch(const HashT hash) const {
     const std::size_t index = computeIndex(hash);
@@ -202,3 +346,236 @@ template <typename PayloadT>
 FORCE_INLINE std::size_t TTable<PayloadT>::computeIndex(const HashT hash) const {
     return hash & mask_;
 }
+
+template <typename PayloadT>
+FORCE_INLINE TTEntry<PayloadT> TTable<PayloadT>::loadEntry(const std::size_t index) const {
+    if constexpr (kIsLockless) {
+        // Relaxed atomic loads and stores compile to plain moves on x86-64.
+        const std::uint64_t payload = data_[index].payload.load(std::memory_order_relaxed);
+        const std::uint64_t hashXorPayload =
+                data_[index].hashXorPayload.load(std::memory_order_relaxed);
+
+        return {.hash = hashXorPayload ^ payload, .payload = std::bit_cast<PayloadT>(payload)};
+    } else {
+        return data_[index];
+    }
+}
+
+template <typename PayloadT>
+FORCE_INLINE void TTable<PayloadT>::storeEntry(const std::size_t index, const EntryT& entry) {
+    if constexpr (kIsLockless) {
+        const auto payload = std::bit_cast<std::uint64_t>(entry.payload);
+
+        data_[index].hashXorPayload.store(entry.hash ^ payload, std::memory_order_relaxed);
+        data_[index].payload.store(payload, std::memory_order_relaxed);
+    } else {
+        data_[index] = entry;
+    }
+}
+
+inline SearchTTable::SearchTTable() : SearchTTable(1) {}
+
+inline SearchTTable::SearchTTable(const std::size_t requestedNumBuckets, const int numThreads)
+    : numBuckets_(std::bit_floor(std::max(requestedNumBuckets, (std::size_t)1))) {
+    // The table is shared by all search threads, so spread it over all NUMA nodes.
+    buckets_ = LargePageArray<Bucket>(numBuckets_, numThreads, /*interleaveOverNumaNodes*/ true);
+
+    // numBuckets_ is a power of 2, so numBuckets_ - 1 is all 1s in binary.
+    mask_ = numBuckets_ - 1;
+}
+
+FORCE_INLINE inline int SearchTTable::computeAge(
+        const std::uint8_t currentTick, const std::uint8_t entryTick) {
+    return (currentTick - entryTick) & (int)kTickMask;
+}
+
+inline void SearchTTable::clear(const int numThreads) {
+    const auto clearRange = [this](const std::size_t begin, const std::size_t end) {
+        for (std::size_t index = begin; index < end; ++index) {
+            for (int slot = 0; slot < kEntriesPerBucket; ++slot) {
+                storeInSlot(buckets_[index], slot, 0, 0);
+            }
+            buckets_[index].epoch.store(epoch_, std::memory_order_relaxed);
+        }
+    };
+    parallelForChunks(numBuckets_, numThreads, clearRange);
+}
+
+inline void SearchTTable::clearLazily() {
+    ++epoch_;
+}
+
+FORCE_INLINE inline std::optional<SearchTTEntry> SearchTTable::probe(const HashT hash) const {
+    const Bucket& bucket = buckets_[computeIndex(hash)];
+
+    if (!isCurrentEpoch(bucket)) {
+        return std::nullopt;
+    }
+
+    for (int slot = 0; slot < kEntriesPerBucket; ++slot) {
+        // Relaxed atomic loads and stores compile to plain moves on x86-64.
+        const std::uint64_t data  = bucket.data[slot].load(std::memory_order_relaxed);
+        const std::uint32_t check = bucket.checks[slot].load(std::memory_order_relaxed);
+
+        if (matches(hash, data, check)) {
+            return EntryT{.hash = hash, .payload = decodePayload(data)};
+        }
+    }
+
+    return std::nullopt;
+}
+
+FORCE_INLINE inline void SearchTTable::prefetch(const HashT hash) const {
+    ::prefetch(&buckets_[computeIndex(hash)]);
+}
+
+template <typename FuncT>
+// NOLINTNEXTLINE(cppcoreguidelines-missing-std-forward), see https://joelfilho.com/blog/2020/forwarding_references/
+FORCE_INLINE void SearchTTable::store(const EntryT& entryToStore, FuncT&& isMoreValuable) {
+    Bucket& bucket = buckets_[computeIndex(entryToStore.hash)];
+
+    const std::uint64_t dataToStore  = encodeData(entryToStore);
+    const std::uint32_t checkToStore = computeCheck(entryToStore.hash, dataToStore);
+
+    // Other threads may modify the bucket between loading and storing. In that case we may lose an
+    // entry, but we never store a corrupted one.
+
+    if (!isCurrentEpoch(bucket)) {
+        // First store to this bucket since the table was lazily cleared: drop the old entries.
+        for (int slot = 0; slot < kEntriesPerBucket; ++slot) {
+            storeInSlot(bucket, slot, 0, 0);
+        }
+        bucket.epoch.store(epoch_, std::memory_order_relaxed);
+    }
+
+    int replaceSlot  = 0;
+    int replaceValue = std::numeric_limits<int>::max();
+
+    for (int slot = 0; slot < kEntriesPerBucket; ++slot) {
+        const std::uint64_t data  = bucket.data[slot].load(std::memory_order_relaxed);
+        const std::uint32_t check = bucket.checks[slot].load(std::memory_order_relaxed);
+
+        if (matches(entryToStore.hash, data, check)) {
+            // Same position, update if more valuable
+            const EntryT existingEntry = {
+                    .hash = entryToStore.hash, .payload = decodePayload(data)};
+            if (isMoreValuable(entryToStore, existingEntry)) {
+                storeInSlot(bucket, slot, dataToStore, checkToStore);
+            }
+            // We either stored the entry or found that we already have more valuable information
+            // for this position. Either way, no need to continue.
+            return;
+        }
+
+        // Otherwise, consider replacing this slot. Prefer empty slots, then the slot with the
+        // lowest depth, compensated for age.
+        int value = std::numeric_limits<int>::min();
+        if (data != 0 || check != 0) {
+            const std::uint8_t tick = (std::uint8_t)((data >> kTickShift) & kTickMask);
+            const int depth         = (int)((data >> kDepthShift) & kMaxDepth);
+            const int age           = computeAge(entryToStore.payload.tick, tick);
+            value                   = depth - age;
+        }
+
+        if (value < replaceValue) {
+            replaceValue = value;
+            replaceSlot  = slot;
+        }
+    }
+
+    storeInSlot(bucket, replaceSlot, dataToStore, checkToStore);
+}
+
+FORCE_INLINE inline bool SearchTTable::erase(const HashT hash) {
+    Bucket& bucket = buckets_[computeIndex(hash)];
+
+    if (!isCurrentEpoch(bucket)) {
+        return false;
+    }
+
+    for (int slot = 0; slot < kEntriesPerBucket; ++slot) {
+        const std::uint64_t data  = bucket.data[slot].load(std::memory_order_relaxed);
+        const std::uint32_t check = bucket.checks[slot].load(std::memory_order_relaxed);
+
+        if (matches(hash, data, check)) {
+            storeInSlot(bucket, slot, 0, 0);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+inline float SearchTTable::getUtilization() const {
+    const std::size_t numSamples = std::min(numBuckets_, kUtilizationSampleSize);
+
+    std::size_t numInUse = 0;
+    for (std::size_t index = 0; index < numSamples; ++index) {
+        const Bucket& bucket = buckets_[index];
+        if (!isCurrentEpoch(bucket)) {
+            continue;
+        }
+        for (int slot = 0; slot < kEntriesPerBucket; ++slot) {
+            const std::uint64_t data  = bucket.data[slot].load(std::memory_order_relaxed);
+            const std::uint32_t check = bucket.checks[slot].load(std::memory_order_relaxed);
+            if (data != 0 || check != 0) {
+                ++numInUse;
+            }
+        }
+    }
+
+    return static_cast<float>(numInUse) / static_cast<float>(numSamples * kEntriesPerBucket);
+}
+
+FORCE_INLINE inline std::uint64_t SearchTTable::encodeData(const EntryT& entry) {
+    const SearchTTPayload& payload = entry.payload;
+
+    const std::uint64_t depth = std::min((std::uint64_t)payload.depth, kMaxDepth);
+
+    return ((std::uint64_t)(std::uint16_t)payload.score << kScoreShift)
+         | ((std::uint64_t)payload.moveFrom << kMoveFromShift)
+         | ((std::uint64_t)payload.moveTo << kMoveToShift)
+         | ((std::uint64_t)getPromotionPiece(payload.moveFlags) << kPromotionShift)
+         | (depth << kDepthShift) | ((std::uint64_t)payload.scoreType << kScoreTypeShift)
+         | (((std::uint64_t)payload.tick & kTickMask) << kTickShift)
+         | ((std::uint64_t)(std::uint16_t)payload.staticEval << kStaticEvalShift)
+         | (((entry.hash >> kKeyHashShift) & kKeyMask) << kKeyShift);
+}
+
+FORCE_INLINE inline SearchTTPayload SearchTTable::decodePayload(const std::uint64_t data) {
+    return {
+            .score      = (EvalT)(std::uint16_t)(data >> kScoreShift),
+            .depth      = (std::uint8_t)((data >> kDepthShift) & kMaxDepth),
+            .tick       = (std::uint8_t)((data >> kTickShift) & kTickMask),
+            .scoreType  = (ScoreType)((data >> kScoreTypeShift) & 7),
+            .moveFrom   = (BoardPosition)((data >> kMoveFromShift) & 63),
+            .moveTo     = (BoardPosition)((data >> kMoveToShift) & 63),
+            .moveFlags  = (MoveFlags)((data >> kPromotionShift) & 7),
+            .staticEval = (EvalT)(std::uint16_t)(data >> kStaticEvalShift),
+    };
+}
+
+FORCE_INLINE inline std::uint32_t SearchTTable::computeCheck(
+        const HashT hash, const std::uint64_t data) {
+    return (std::uint32_t)(hash >> 32) ^ (std::uint32_t)data ^ (std::uint32_t)(data >> 32);
+}
+
+FORCE_INLINE inline bool SearchTTable::matches(
+        const HashT hash, const std::uint64_t data, const std::uint32_t check) {
+    return (data >> kKeyShift) == ((hash >> kKeyHashShift) & kKeyMask)
+        && check == computeCheck(hash, data);
+}
+
+FORCE_INLINE inline std::size_t SearchTTable::computeIndex(const HashT hash) const {
+    return hash & mask_;
+}
+
+FORCE_INLINE inline bool SearchTTable::isCurrentEpoch(const Bucket& bucket) const {
+    return bucket.epoch.load(std::memory_order_relaxed) == epoch_;
+}
+
+FORCE_INLINE inline void SearchTTable::storeInSlot(
+        Bucket& bucket, const int slot, const std::uint64_t data, const std::uint32_t check) {
+    bucket.data[slot].store(data, std::memory_order_relaxed);
+    bucket.checks[slot].store(check, std::memory_order_relaxed);
+}
@@ -6,10 +6,10 @@
 #include "Math.h"
 #include "MyAssert.h"
 #include "RangePatches.h"
+#include "WorkerThread.h"
 
 #include <algorithm>
 #include <atomic>
-#include <future>
 #include <iostream>
 #include <map>
 #include <optional>
@@ -144,7 +144,9 @@ class UciFrontEnd::Impl final : public IFrontEnd {
     std::map<std::string, FrontEndOption, std::less<>> optionsMap_;
 
     std::atomic<bool> searchHasStarted_{false};
-    std::future<void> goFuture_;
+
+    // Runs the searches started by 'go'. The thread is reused for all searches.
+    WorkerThread goThread_;
 };
 
 UciFrontEnd::Impl::Impl(
@@ -167,7 +169,7 @@ UciFrontEnd::Impl::Impl(
 }
 
 UciFrontEnd::Impl::~Impl() {
-    MY_ASSERT(!goFuture_.valid());
+    MY_ASSERT(!goThread_.isBusy());
 }
 
 void UciFrontEnd::Impl::run() {
@@ -276,6 +278,12 @@ void UciFrontEnd::Impl::reportSearchStatistics(const SearchStatistics& searchSta
         writeDebug("Quiescence nodes searched: {}", searchStatistics.qNodesSearched);
         writeDebug("TTable hits: {}", searchStatistics.tTableHits);
         writeDebug("TTable utilization: {:.1f}%", searchStatistics.ttableUtilization * 100.f);
+        if (searchStatistics.evalHashProbes > 0) {
+            writeDebug(
+                    "Eval hash hit rate: {:.1f}%",
+                    (double)searchStatistics.evalHashHits * 100.
+                            / (double)searchStatistics.evalHashProbes);
+        }
     }
 }
 
@@ -348,6 +356,7 @@ void UciFrontEnd::Impl::addOption(FrontEndOption option) {
 
 void UciFrontEnd::Impl::handleIsReady() {
     waitForGoToComplete();
+    engine_.waitUntilReady();
     writeUci("readyok");
     std::flush(out_);
 }
@@ -530,11 +539,11 @@ void UciFrontEnd::Impl::handleGo(std::stringstream& lineSStream) {
         timeManager.configureForFixedTimeSearch(std::chrono::seconds(1));
     }
 
-    MY_ASSERT(!goFuture_.valid());
+    MY_ASSERT(!goThread_.isBusy());
 
     searchHasStarted_ = false;
 
-    goFuture_ = std::async(std::launch::async, [searchMoves, this] {
+    goThread_.start([searchMoves, this] {
         try {
             const auto searchInfo = engine_.findMove(gameState_, searchMoves);
 
@@ -673,16 +682,14 @@ void UciFrontEnd::Impl::handleListMoves() {
 }
 
 void UciFrontEnd::Impl::stopSearchIfNeeded() {
-    if (goFuture_.valid()) {
+    if (goThread_.isBusy()) {
         engine_.interruptSearch();
-        goFuture_.get();
+        goThread_.wait();
     }
 }
 
 void UciFrontEnd::Impl::waitForGoToComplete() {
-    if (goFuture_.valid()) {
-        goFuture_.get();
-    }
+    goThread_.wait();
 }
 
 void UciFrontEnd::Impl::writeOptions() const {
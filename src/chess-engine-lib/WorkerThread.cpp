@@ -0,0 +1,68 @@
+#include "WorkerThread.h"
+
+#include "MyAssert.h"
+
+WorkerThread::WorkerThread() : thread_(&WorkerThread::run, this) {}
+
+WorkerThread::~WorkerThread() {
+    wait();
+
+    {
+        std::lock_guard lock(mutex_);
+        shouldQuit_ = true;
+    }
+    condition_.notify_all();
+
+    thread_.join();
+}
+
+void WorkerThread::start(std::function<void()> job) {
+    {
+        std::lock_guard lock(mutex_);
+        MY_ASSERT(!isBusy_);
+
+        job_    = std::move(job);
+        isBusy_ = true;
+    }
+    condition_.notify_all();
+}
+
+void WorkerThread::wait() {
+    std::unique_lock lock(mutex_);
+    condition_.wait(lock, [this] { return !isBusy_; });
+}
+
+bool WorkerThread::waitFor(const std::chrono::milliseconds timeout) {
+    std::unique_lock lock(mutex_);
+    return condition_.wait_for(lock, timeout, [this] { return !isBusy_; });
+}
+
+bool WorkerThread::isBusy() const {
+    std::lock_guard lock(mutex_);
+    return isBusy_;
+}
+
+void WorkerThread::run() {
+    while (true) {
+        std::function<void()> job;
+
+        {
+            std::unique_lock lock(mutex_);
+            condition_.wait(lock, [this] { return isBusy_ || shouldQuit_; });
+
+            if (!isBusy_) {
+                return;
+            }
+
+            job = std::move(job_);
+        }
+
+        job();
+
+        {
+            std::lock_guard lock(mutex_);
+            isBusy_ = false;
+        }
+        condition_.notify_all();
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// A persistent thread that runs jobs one at a time. Between jobs the thread is parked on a
+// condition variable, so running a job doesn't require creating a new thread.
+class WorkerThread {
+  public:
+    WorkerThread();
+    ~WorkerThread();
+
+    WorkerThread(const WorkerThread&)            = delete;
+    WorkerThread& operator=(const WorkerThread&) = delete;
+
+    WorkerThread(WorkerThread&&)            = delete;
+    WorkerThread& operator=(WorkerThread&&) = delete;
+
+    // Run job on the worker thread. The worker must be idle.
+    void start(std::function<void()> job);
+
+    // Block until the current job (if any) has completed.
+    void wait();
+
+    // Like wait(), but give up after timeout. Returns true if the worker is idle.
+    bool waitFor(std::chrono::milliseconds timeout);
+
+    [[nodiscard]] bool isBusy() const;
+
+  private:
+    void run();
+
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+
+    std::function<void()> job_;
+    bool isBusy_     = false;
+    bool shouldQuit_ = false;
+
+    // Declared last so that the other members are initialized before the thread starts.
+    std::thread thread_;
+};
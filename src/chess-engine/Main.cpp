@@ -1,6 +1,8 @@
 #include "chess-engine-lib/Engine.h"
 #include "chess-engine-lib/Math.h"
 #include "chess-engine-lib/Perft.h"
+#include "chess-engine-lib/PieceControl.h"
+#include "chess-engine-lib/SliderAttackBenchmark.h"
 #include "chess-engine-lib/UciFrontEnd.h"
 
 #include <iostream>
@@ -14,6 +16,44 @@ void runPerft() {
     perftPrint(gameState, 7, true);
 }
 
+// Usage: perftmt <depth> <threads> <hash MB>
+void runParallelPerft() {
+    int depth{};
+    int numThreads{};
+    int tTableSizeInMb{};
+    std::cin >> depth >> numThreads >> tTableSizeInMb;
+
+    perftParallelPrint(
+            GameState::startingPosition(), depth, max(numThreads, 1), max(tTableSizeInMb, 0));
+}
+
+// Usage: perftsuite <EPD file> <max depth> <threads> <hash MB>
+void runPerftSuite() {
+    std::string epdFilePath;
+    int maxDepth{};
+    int numThreads{};
+    int tTableSizeInMb{};
+    std::cin >> epdFilePath >> maxDepth >> numThreads >> tTableSizeInMb;
+
+    perftSuitePrint(epdFilePath, maxDepth, max(numThreads, 1), max(tTableSizeInMb, 0));
+}
+
+// Usage: sliderattacks <pext-packed|pext-unpacked|magic>
+void selectSliderAttackBackend() {
+    std::string backend;
+    std::cin >> backend;
+
+    if (backend == "pext-packed") {
+        setSliderAttackBackend(SliderAttackBackend::PextPacked);
+    } else if (backend == "pext-unpacked") {
+        setSliderAttackBackend(SliderAttackBackend::PextUnpacked);
+    } else if (backend == "magic") {
+        setSliderAttackBackend(SliderAttackBackend::Magic);
+    } else {
+        std::println(std::cerr, "Unknown slider attack backend '{}'.", backend);
+    }
+}
+
 int main() try {
     std::locale::global(std::locale("en_US.UTF-8"));
 
@@ -28,6 +68,14 @@ int main() try {
             break;
         } else if (command == "perft") {
             runPerft();
+        } else if (command == "perftmt") {
+            runParallelPerft();
+        } else if (command == "perftsuite") {
+            runPerftSuite();
+        } else if (command == "sliderattacks") {
+            selectSliderAttackBackend();
+        } else if (command == "sliderbench") {
+            sliderAttackBenchmarkPrint();
         } else if (command == "exit") {
             break;
         }
@@ -4,6 +4,7 @@
 #include "MyGTest.h"
 
 #include <memory>
+#include <vector>
 
 namespace EvalJacobiansTests {
 
@@ -58,13 +59,23 @@ TEST(EvalJacobiansTests, TestJacobians) {
     for (const GameState& gameState : gameStates) {
         const EvalWithGradient evalWithGradient = defaultEvaluator->evaluateWithGradient(gameState);
 
+        // The sparse gradient should be sorted by param index, with at most one entry per param.
+        std::vector<double> denseGradient(kNumEvalParams, 0.);
+        for (std::size_t entryIdx = 0; entryIdx < evalWithGradient.gradient.size(); ++entryIdx) {
+            const auto& [paramIdx, derivative] = evalWithGradient.gradient[entryIdx];
+            if (entryIdx > 0) {
+                EXPECT_GT(paramIdx, evalWithGradient.gradient[entryIdx - 1].paramIdx);
+            }
+            denseGradient[paramIdx] = derivative;
+        }
+
         for (std::size_t paramIdx = 0; paramIdx < kNumEvalParams; ++paramIdx) {
             const EvalCalcT defaultValue = defaultParamArray[paramIdx];
             const EvalCalcT epsilon      = max(1e-2f, 1e-2f * std::abs(defaultValue));
             const double numericDeriv =
                     numericDerivative(gameState, defaultParamArray, paramIdx, epsilon);
 
-            const double symbolicDeriv = evalWithGradient.gradient[paramIdx];
+            const double symbolicDeriv = denseGradient[paramIdx];
 
             EXPECT_NEAR(numericDeriv, symbolicDeriv, 1e-1)
                     << paramIdx << " fen: " << gameState.toFen();
@@ -0,0 +1,124 @@
+#include "chess-engine-lib/Eval.h"
+#include "chess-engine-lib/GameState.h"
+#include "chess-engine-lib/Math.h"
+
+#include "MyGTest.h"
+#include "PositionWalk.h"
+
+#include <vector>
+
+namespace EvalTests {
+
+using PositionWalk::collectPositions;
+
+// With EUWE_CONSTEXPR_EVAL_PARAMS, evaluate uses an instantiation of the evaluation that's
+// specialized for the default params at compile time, while evaluateRaw always uses the runtime
+// params. Check that both give the same evaluation.
+TEST(EvalTests, DefaultParamsSpecializationMatchesRuntimeParams) {
+    const Evaluator evaluator(EvalParams::getDefaultParams());
+    StackOfVectors<Move> stack;
+    stack.reserve(1'000);
+
+    std::vector<GameState> positions;
+    for (const std::string_view fen : PositionWalk::kMakeUnmakeFens) {
+        GameState gameState = GameState::fromFen(fen);
+        collectPositions(gameState, stack, 2, positions);
+    }
+    // Also check an endgame, where the drawishness corrections may apply.
+    GameState endgame = GameState::fromFen("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1");
+    collectPositions(endgame, stack, 2, positions);
+
+    for (const GameState& position : positions) {
+        const EvalT runtimeParamsEval = (EvalT)clamp(
+                (int)evaluator.evaluateRaw(position), -kMateEval + 1'000, kMateEval - 1'000);
+
+        EXPECT_EQ(evaluator.evaluate(position), runtimeParamsEval);
+    }
+}
+
+TEST(EvalTests, BatchMatchesSingleEvaluations) {
+    const Evaluator evaluator(EvalParams::getDefaultParams(), /*usePawnKingEvalHashTable*/ true);
+    StackOfVectors<Move> stack;
+    stack.reserve(1'000);
+
+    std::vector<GameState> positions;
+    GameState gameState = GameState::fromFen(PositionWalk::kMakeUnmakeFens[0]);
+    collectPositions(gameState, stack, 2, positions);
+
+    for (const int numThreads : {1, 3}) {
+        std::vector<EvalT> evals(positions.size());
+        evaluator.evaluateBatch(positions, evals, numThreads);
+
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            EXPECT_EQ(evals[i], evaluator.evaluate(positions[i]));
+        }
+
+        std::vector<EvalWithGradient> evalsWithGradient(positions.size());
+        evaluator.evaluateWithGradientBatch(positions, evalsWithGradient, numThreads);
+
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            const EvalWithGradient expected = evaluator.evaluateWithGradient(positions[i]);
+
+            EXPECT_EQ(evalsWithGradient[i].eval, expected.eval);
+            ASSERT_EQ(evalsWithGradient[i].gradient.size(), expected.gradient.size());
+            for (std::size_t entryIdx = 0; entryIdx < expected.gradient.size(); ++entryIdx) {
+                EXPECT_EQ(
+                        evalsWithGradient[i].gradient[entryIdx].paramIdx,
+                        expected.gradient[entryIdx].paramIdx);
+                EXPECT_EQ(
+                        evalsWithGradient[i].gradient[entryIdx].derivative,
+                        expected.gradient[entryIdx].derivative);
+            }
+        }
+    }
+}
+
+TEST(EvalTests, MaterialInfo) {
+    MaterialTable materialTable;
+    const EvalParams params = EvalParams::getDefaultParams();
+
+    const auto probe = [&](const std::string_view fen) {
+        return materialTable.probe(GameState::fromFen(fen).getMaterialKey(), params);
+    };
+
+    const MaterialInfo startingPosition = probe(getStartingPositionFen());
+    EXPECT_FALSE(startingPosition.insufficientMaterial[(int)Side::White]);
+    EXPECT_FALSE(startingPosition.insufficientMaterial[(int)Side::Black]);
+    EXPECT_EQ(startingPosition.specializedEndgame, SpecializedEndgame::None);
+
+    const MaterialInfo knightVsKing = probe("8/8/8/4k3/8/8/8/K1N5 w - - 0 1");
+    EXPECT_TRUE(knightVsKing.insufficientMaterial[(int)Side::White]);
+    EXPECT_TRUE(knightVsKing.insufficientMaterial[(int)Side::Black]);
+    EXPECT_EQ(knightVsKing.specializedEndgame, SpecializedEndgame::None);
+
+    const MaterialInfo knightBishopVsKing = probe("8/8/8/4k3/8/8/8/2bnK3 w - - 0 1");
+    EXPECT_TRUE(knightBishopVsKing.insufficientMaterial[(int)Side::White]);
+    EXPECT_FALSE(knightBishopVsKing.insufficientMaterial[(int)Side::Black]);
+    EXPECT_EQ(knightBishopVsKing.specializedEndgame, SpecializedEndgame::KnightBishopVsKing);
+    EXPECT_EQ(knightBishopVsKing.specializedEndgameStrongerSide, Side::Black);
+
+    // Probing again hits the table, which must return the same info.
+    const MaterialInfo knightBishopVsKingCached = probe("8/8/8/4k3/8/8/8/2bnK3 w - - 0 1");
+    EXPECT_EQ(knightBishopVsKingCached.insufficientMaterial, knightBishopVsKing.insufficientMaterial);
+    EXPECT_EQ(knightBishopVsKingCached.specializedEndgame, knightBishopVsKing.specializedEndgame);
+    EXPECT_EQ(
+            knightBishopVsKingCached.specializedEndgameStrongerSide,
+            knightBishopVsKing.specializedEndgameStrongerSide);
+}
+
+// In KBN vs K the weaker king should be driven to a corner of the bishop's color.
+TEST(EvalTests, KnightBishopVsKingPrefersBishopColoredCorner) {
+    const Evaluator evaluator(EvalParams::getDefaultParams());
+
+    // Dark squared bishop: h8 is the right corner, a8 the wrong one.
+    EXPECT_GT(
+            evaluator.evaluate(GameState::fromFen("7k/8/8/8/3K4/8/8/2B1N3 w - - 0 1")),
+            evaluator.evaluate(GameState::fromFen("k7/8/8/8/3K4/8/8/2B1N3 w - - 0 1")));
+
+    // Light squared bishop: a8 is the right corner, h8 the wrong one.
+    EXPECT_GT(
+            evaluator.evaluate(GameState::fromFen("k7/8/8/8/3K4/8/8/4NB2 w - - 0 1")),
+            evaluator.evaluate(GameState::fromFen("7k/8/8/8/3K4/8/8/4NB2 w - - 0 1")));
+}
+
+}  // namespace EvalTests
@@ -1,9 +1,41 @@
 #include "chess-engine-lib/GameState.h"
 
 #include "MyGTest.h"
+#include "PositionWalk.h"
 
 namespace GameStateTests {
 
+namespace {
+
+// Check that the incrementally updated material key matches one computed from scratch.
+void checkMaterialKey(const GameState& gameState) {
+    ASSERT_EQ(gameState.getMaterialKey(), GameState::fromFen(gameState.toFen()).getMaterialKey());
+}
+
+}  // namespace
+
+TEST(GameStateTests, MaterialKeyIncrementalUpdates) {
+    StackOfVectors<Move> stack;
+    stack.reserve(1'000);
+
+    for (const std::string_view fen : PositionWalk::kMakeUnmakeFens) {
+        GameState gameState = GameState::fromFen(fen);
+        PositionWalk::forEachPosition(
+                gameState, stack, 3, checkMaterialKey, [](const GameState& position) {
+                    return position.getMaterialKey();
+                });
+    }
+
+    const MaterialKey materialKey = GameState::startingPosition().getMaterialKey();
+    EXPECT_EQ(materialKey.getCount(Side::White, Piece::Pawn), 8);
+    EXPECT_EQ(materialKey.getCount(Side::Black, Piece::Bishop), 2);
+    EXPECT_EQ(materialKey.getBishopCount(Side::Black, getSquareColor(BoardPosition::C8)), 1);
+    EXPECT_EQ(materialKey.getCount(Side::Black, Piece::Queen), 1);
+    EXPECT_TRUE(GameState::fromFen("4k3/8/8/8/8/8/8/R3K3 w - - 0 1")
+                        .getMaterialKey()
+                        .hasNone(Side::Black, Piece::Rook));
+}
+
 TEST(GameStateTests, ThreeFoldRepetition) {
     // Position from https://en.wikipedia.org/wiki/Threefold_repetition "Fischer vs. Petrosian, 1971"
     const std::string fischerPetrosianFen = "8/pp3p1k/2p2q1p/3r1P2/5R2/7P/P1P1QP2/7K b - - 0 1";
@@ -3,6 +3,7 @@
 #include "chess-engine-lib/TTable.h"
 
 #include "MyGTest.h"
+#include "PositionWalk.h"
 
 #include <algorithm>
 #include <format>
@@ -132,6 +133,80 @@ void countMoveStatisticsAtPlyWithUnmake(
     }
 }
 
+// Checks that the tactical and quiet moves together are exactly the legal moves, at all nodes up to
+// the given ply.
+void checkStagedMoveGenerationAtPly(GameState& gameState, int ply, StackOfVectors<Move>& stack) {
+    const BoardControl boardControl = gameState.getBoardControl();
+
+    const StackVector<Move> moves = gameState.generateMoves(stack, boardControl);
+
+    std::vector<Move> stagedMoves;
+    {
+        const StackVector<Move> tacticalMoves =
+                gameState.generateTacticalMoves(stack, boardControl);
+        for (const Move move : tacticalMoves) {
+            EXPECT_TRUE(isCaptureOrQueenPromo(move));
+            stagedMoves.push_back(move);
+        }
+    }
+    {
+        const StackVector<Move> quietMoves = gameState.generateQuietMoves(stack, boardControl);
+        for (const Move move : quietMoves) {
+            EXPECT_FALSE(isCaptureOrQueenPromo(move));
+            stagedMoves.push_back(move);
+        }
+    }
+
+    EXPECT_EQ(stagedMoves.size(), moves.size());
+    for (const Move move : moves) {
+        EXPECT_EQ(std::ranges::count(stagedMoves, move), 1);
+    }
+
+    if (ply <= 1) {
+        return;
+    }
+    for (const Move move : moves) {
+        auto unmakeInfo = gameState.makeMove(move);
+        checkStagedMoveGenerationAtPly(gameState, ply - 1, stack);
+        gameState.unmakeMove(move, unmakeInfo);
+    }
+}
+
+// Checks that isPseudoLegal and isLegal accept exactly the legal moves out of all quiet moves that
+// are legal in some position reachable within the given ply, like killer and counter moves are.
+void checkQuietMoveLegality(GameState& gameState, int ply, StackOfVectors<Move>& stack) {
+    std::vector<GameState> positions;
+    PositionWalk::collectPositions(gameState, stack, ply, positions);
+
+    std::vector<Move> candidateMoves;
+    for (const GameState& position : positions) {
+        const StackVector<Move> moves = position.generateMoves(stack);
+        for (const Move move : moves) {
+            if (!isCapture(move) && !isPromotion(move)
+                && std::ranges::find(candidateMoves, move) == candidateMoves.end()) {
+                candidateMoves.push_back(move);
+            }
+        }
+    }
+
+    for (const GameState& position : positions) {
+        const BoardControl boardControl = position.getBoardControl();
+        if (position.isInCheck(boardControl)) {
+            continue;
+        }
+
+        const StackVector<Move> moves = position.generateMoves(stack, boardControl);
+        for (const Move move : candidateMoves) {
+            const bool isLegal =
+                    position.isPseudoLegal(move) && position.isLegal(move, boardControl);
+            const bool isGenerated = std::find(moves.begin(), moves.end(), move) != moves.end();
+
+            EXPECT_EQ(isLegal, isGenerated)
+                    << position.toFen() << " " << move.toExtendedString();
+        }
+    }
+}
+
 using StatisticsTTable = TTable<MoveStatistics>;
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
@@ -241,6 +316,23 @@ TEST_P(ValidateMoveStatsWithTTable, TestMoveStats) {
     compareStatistics(statistics, config.expectedStats);
 }
 
+class ValidateStagedMoveGeneration : public ::testing::TestWithParam<TestStatsConfig> {};
+
+TEST_P(ValidateStagedMoveGeneration, TacticalAndQuietMovesMatchAllMoves) {
+    const TestStatsConfig config = GetParam();
+    GameState gameState          = GameState::fromFen(config.fen);
+    StackOfVectors<Move> stack;
+    checkStagedMoveGenerationAtPly(gameState, config.depth, stack);
+}
+
+TEST_P(ValidateStagedMoveGeneration, QuietMoveLegalityMatchesMoveGeneration) {
+    const TestStatsConfig config = GetParam();
+    GameState gameState          = GameState::fromFen(config.fen);
+    StackOfVectors<Move> stack;
+    stack.reserve(1'000);
+    checkQuietMoveLegality(gameState, std::min(config.depth, 2), stack);
+}
+
 // Positions and statistics taken from https://www.chessprogramming.org/Perft_Results
 
 namespace {
@@ -607,6 +699,18 @@ INSTANTIATE_TEST_SUITE_P(
 INSTANTIATE_TEST_SUITE_P(
         MoveGeneration, ValidateMoveStatsWithTTable, testCasesFast, validateMoveStatsName);
 
+const auto stagedTestCases = ::testing::Values(
+        TestStatsConfig{.fen = kKiwipeteFen, .depth = 3, .expectedStats = {}},
+        TestStatsConfig{.fen = kPosition3Fen, .depth = 4, .expectedStats = {}},
+        TestStatsConfig{.fen = kPosition4Fen, .depth = 3, .expectedStats = {}},
+        TestStatsConfig{.fen = kPosition5Fen, .depth = 3, .expectedStats = {}},
+        TestStatsConfig{.fen = kInCheckByPawn, .depth = 3, .expectedStats = {}},
+        TestStatsConfig{.fen = kBlackAboutToPromote, .depth = 3, .expectedStats = {}},
+        TestStatsConfig{.fen = kEnPassantNoDiscoveredCheck, .depth = 3, .expectedStats = {}});
+
+INSTANTIATE_TEST_SUITE_P(
+        MoveGeneration, ValidateStagedMoveGeneration, stagedTestCases, validateMoveStatsName);
+
 #ifdef NDEBUG
 INSTANTIATE_TEST_SUITE_P(
         MoveGenerationSlow, ValidateMoveStatsWithUnmake, testCasesSlow, validateMoveStatsName);
@@ -0,0 +1,189 @@
+#include "chess-engine-lib/Eval.h"
+#include "chess-engine-lib/GameState.h"
+#include "chess-engine-lib/MoveSearcher.h"
+#include "chess-engine-lib/Nnue.h"
+#include "chess-engine-lib/TimeManager.h"
+
+#include "MyGTest.h"
+#include "PositionWalk.h"
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <random>
+
+namespace NnueTests {
+
+namespace {
+
+template <typename T>
+void writeRandomValues(
+        std::ofstream& file,
+        const std::size_t count,
+        std::mt19937& rng,
+        const int min,
+        const int max) {
+    std::uniform_int_distribution<int> distribution(min, max);
+    for (std::size_t i = 0; i < count; ++i) {
+        const T value = (T)distribution(rng);
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+}
+
+// Write a network with random weights to a temporary file and return its path.
+std::filesystem::path writeRandomNetwork() {
+    const std::filesystem::path path =
+            std::filesystem::temp_directory_path() / "euwe-nnue-tests.nnue";
+
+    std::ofstream file(path, std::ios::binary);
+
+    NnueNetwork::FileHeader header{
+            .magic       = NnueNetwork::FileHeader::kMagic,
+            .version     = NnueNetwork::FileHeader::kVersion,
+            .numInputs   = kNnueNumInputs,
+            .hiddenSize  = kNnueHiddenSize,
+            .l2Size      = kNnueL2Size,
+            .outputScale = 1 << 16,
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    constexpr std::size_t kNumFeatureWeights = (std::size_t)kNnueNumInputs * kNnueHiddenSize;
+    constexpr std::size_t kNumHiddenWeights  = (std::size_t)kNnueL2Size * 2 * kNnueHiddenSize;
+
+    std::mt19937 rng(42);
+    writeRandomValues<std::int16_t>(file, kNumFeatureWeights, rng, -32, 32);
+    writeRandomValues<std::int16_t>(file, kNnueHiddenSize, rng, 0, 64);
+    writeRandomValues<std::int8_t>(file, kNumHiddenWeights, rng, -64, 64);
+    writeRandomValues<std::int32_t>(file, kNnueL2Size, rng, -1'000, 1'000);
+    writeRandomValues<std::int8_t>(file, kNnueL2Size, rng, -127, 127);
+    writeRandomValues<std::int32_t>(file, 1, rng, -100, 100);
+
+    return path;
+}
+
+// Check that the incrementally updated accumulator matches a refreshed one, and that evaluating
+// with it matches evaluating without it.
+void checkAccumulator(const Evaluator& evaluator, const GameState& gameState) {
+    GameState refreshed = gameState;
+    refreshed.setNnueNetwork(gameState.getNnueNetwork());
+    ASSERT_EQ(gameState.getNnueAccumulator(), refreshed.getNnueAccumulator());
+
+    GameState unaccumulated = gameState;
+    unaccumulated.setNnueNetwork(nullptr);
+    EXPECT_EQ(evaluator.evaluate(gameState), evaluator.evaluate(unaccumulated));
+}
+
+struct SearchResult {
+    RootSearchResult rootResult;
+    std::uint64_t nodesSearched;
+};
+
+// Search the position with iterative deepening, like Engine::findMove does.
+SearchResult searchToDepth(
+        MoveSearcher& searcher,
+        const Evaluator& evaluator,
+        const GameState& gameState,
+        const int depth) {
+    StackOfVectors<Move> stack;
+    stack.reserve(1'000);
+
+    searcher.resetSearchStatistics();
+    searcher.prepareForNewSearch(gameState, /*movesToSearch*/ nullptr, /*tbHitAtRoot*/ false);
+
+    GameState copyState(gameState);
+    evaluator.attachNnueAccumulator(copyState);
+
+    RootSearchResult rootResult;
+    std::optional<EvalT> evalGuess = std::nullopt;
+    for (int currentDepth = 1; currentDepth <= depth; ++currentDepth) {
+        rootResult = searcher.searchForBestMove(copyState, currentDepth, stack, evalGuess);
+        evalGuess  = rootResult.eval;
+    }
+
+    const SearchStatistics statistics = searcher.getSearchStatistics();
+    return {rootResult, statistics.normalNodesSearched + statistics.qNodesSearched};
+}
+
+}  // namespace
+
+TEST(NnueTests, IncrementalUpdates) {
+    const std::filesystem::path path = writeRandomNetwork();
+
+    Evaluator evaluator;
+    evaluator.setNnueNetwork(NnueNetwork::loadFromFile(path.string()));
+
+    StackOfVectors<Move> stack;
+    stack.reserve(1'000);
+
+    for (const std::string_view fen : PositionWalk::kMakeUnmakeFens) {
+        GameState gameState = GameState::fromFen(fen);
+        evaluator.attachNnueAccumulator(gameState);
+
+        PositionWalk::forEachPosition(
+                gameState,
+                stack,
+                3,
+                [&](const GameState& position) { checkAccumulator(evaluator, position); },
+                [](const GameState& position) { return position.getNnueAccumulator(); });
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(NnueTests, SwitchingBackendClearsTTable) {
+    constexpr int kDepth = 6;
+
+    const std::filesystem::path path = writeRandomNetwork();
+    const auto network               = NnueNetwork::loadFromFile(path.string());
+
+    const GameState gameState = GameState::fromFen(getStartingPositionFen());
+
+    TimeManager timeManager;
+    timeManager.configureForFixedDepthSearch(kDepth);
+
+    // Fill the transposition table with the hand-crafted evaluation, then switch to NNUE.
+    Evaluator switchedEvaluator;
+    MoveSearcher switchedSearcher(timeManager, switchedEvaluator);
+    (void)searchToDepth(switchedSearcher, switchedEvaluator, gameState, kDepth);
+    ASSERT_TRUE(switchedSearcher.getRootNodeInfo(gameState).has_value());
+
+    switchedEvaluator.setNnueNetwork(network);
+    switchedSearcher.setNnueNetwork(network);
+    switchedSearcher.waitUntilReady();
+    EXPECT_FALSE(switchedSearcher.getRootNodeInfo(gameState).has_value());
+
+    const SearchResult switchedResult =
+            searchToDepth(switchedSearcher, switchedEvaluator, gameState, kDepth);
+
+    // A searcher that used NNUE from the start must search exactly the same tree.
+    Evaluator freshEvaluator;
+    freshEvaluator.setNnueNetwork(network);
+    MoveSearcher freshSearcher(timeManager, freshEvaluator);
+    freshSearcher.setNnueNetwork(network);
+
+    const SearchResult freshResult =
+            searchToDepth(freshSearcher, freshEvaluator, gameState, kDepth);
+
+    EXPECT_EQ(switchedResult.rootResult.eval, freshResult.rootResult.eval);
+    EXPECT_EQ(
+            switchedResult.rootResult.principalVariation,
+            freshResult.rootResult.principalVariation);
+    EXPECT_EQ(switchedResult.nodesSearched, freshResult.nodesSearched);
+
+    std::filesystem::remove(path);
+}
+
+TEST(NnueTests, InvalidFile) {
+    const std::filesystem::path path =
+            std::filesystem::temp_directory_path() / "euwe-nnue-tests-invalid.nnue";
+    std::ofstream(path, std::ios::binary) << "not a network";
+
+    EXPECT_THROW((void)NnueNetwork::loadFromFile(path.string()), std::invalid_argument);
+    EXPECT_THROW(
+            (void)NnueNetwork::loadFromFile((path / "does-not-exist").string()),
+            std::invalid_argument);
+
+    std::filesystem::remove(path);
+}
+
+}  // namespace NnueTests
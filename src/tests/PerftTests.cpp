@@ -0,0 +1,53 @@
+#include "chess-engine-lib/Perft.h"
+#include "chess-engine-lib/PieceControl.h"
+
+#include "MyGTest.h"
+
+namespace PerftTests {
+
+namespace {
+
+const std::string kKiwipeteFen =
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+const std::string kPosition3Fen = "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1";
+
+}  // namespace
+
+// Node counts taken from https://www.chessprogramming.org/Perft_Results
+
+TEST(PerftTests, TestParallelPerft) {
+    EXPECT_EQ(perftParallel(GameState::startingPosition(), 4, 4), 197'281);
+    EXPECT_EQ(perftParallel(GameState::fromFen(kKiwipeteFen), 3, 3), 97'862);
+    EXPECT_EQ(perftParallel(GameState::fromFen(kPosition3Fen), 5, 2), 674'624);
+}
+
+TEST(PerftTests, TestParallelPerftWithTTable) {
+    // A tiny table forces lots of collisions and replacements.
+    PerftTTable tTable(1024);
+
+    EXPECT_EQ(perftParallel(GameState::startingPosition(), 4, 4, &tTable), 197'281);
+    EXPECT_EQ(perftParallel(GameState::fromFen(kKiwipeteFen), 3, 3, &tTable), 97'862);
+    EXPECT_EQ(perftParallel(GameState::fromFen(kPosition3Fen), 5, 2, &tTable), 674'624);
+
+    // Reusing the table must give the same results.
+    EXPECT_EQ(perftParallel(GameState::fromFen(kPosition3Fen), 5, 2, &tTable), 674'624);
+}
+
+TEST(PerftTests, TestSliderAttackBackends) {
+    const SliderAttackBackend originalBackend = getSliderAttackBackend();
+
+    for (const auto backend :
+         {SliderAttackBackend::PextPacked,
+          SliderAttackBackend::PextUnpacked,
+          SliderAttackBackend::Magic}) {
+        setSliderAttackBackend(backend);
+
+        EXPECT_EQ(perftParallel(GameState::startingPosition(), 4, 1), 197'281);
+        EXPECT_EQ(perftParallel(GameState::fromFen(kKiwipeteFen), 3, 1), 97'862);
+        EXPECT_EQ(perftParallel(GameState::fromFen(kPosition3Fen), 5, 1), 674'624);
+    }
+
+    setSliderAttackBackend(originalBackend);
+}
+
+}  // namespace PerftTests
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "chess-engine-lib/GameState.h"
+
+#include "MyGTest.h"
+
+#include <array>
+#include <string_view>
+#include <vector>
+
+namespace PositionWalk {
+
+// Kiwipete (castling on both sides, en passant, lots of captures) and a position with promotions.
+// Walking a few plies from these covers all kinds of moves.
+inline constexpr std::array<std::string_view, 2> kMakeUnmakeFens = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+};
+
+// Call visit on gameState and on all positions reachable from it in at most depth moves, by making
+// and unmaking the moves on gameState itself. getState extracts incrementally updated state from
+// the position; it's checked to be restored exactly after unmaking each move.
+template <typename VisitFuncT, typename GetStateFuncT>
+void forEachPosition(
+        GameState& gameState,
+        StackOfVectors<Move>& stack,
+        const int depth,
+        const VisitFuncT& visit,
+        const GetStateFuncT& getState) {
+    visit(gameState);
+
+    if (depth == 0) {
+        return;
+    }
+
+    const auto stateBefore = getState(gameState);
+
+    const auto moves = gameState.generateMoves(stack);
+    for (const auto& move : moves) {
+        const auto unmakeInfo = gameState.makeMove(move);
+        forEachPosition(gameState, stack, depth - 1, visit, getState);
+        gameState.unmakeMove(move, unmakeInfo);
+
+        ASSERT_EQ(getState(gameState), stateBefore);
+    }
+}
+
+template <typename VisitFuncT>
+void forEachPosition(
+        GameState& gameState,
+        StackOfVectors<Move>& stack,
+        const int depth,
+        const VisitFuncT& visit) {
+    forEachPosition(gameState, stack, depth, visit, [](const GameState&) { return 0; });
+}
+
+// Append gameState and all positions reachable from it in at most depth moves to positions.
+inline void collectPositions(
+        GameState& gameState,
+        StackOfVectors<Move>& stack,
+        const int depth,
+        std::vector<GameState>& positions) {
+    forEachPosition(gameState, stack, depth, [&](const GameState& position) {
+        positions.push_back(position);
+    });
+}
+
+}  // namespace PositionWalk
@@ -0,0 +1,142 @@
+#include "chess-engine-lib/TTable.h"
+
+#include "MyGTest.h"
+
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace TTableTests {
+
+namespace {
+
+// Derive a payload from the hash, so that probes can check that the payload belongs to the hash.
+SearchTTPayload payloadForHash(const HashT hash) {
+    return {.score      = (EvalT)(hash >> 48),
+            .depth      = (std::uint8_t)((hash >> 8) & 63),
+            .tick       = (std::uint8_t)((hash >> 16) & 31),
+            .scoreType  = ScoreType::Exact,
+            .moveFrom   = (BoardPosition)((hash >> 24) & 63),
+            .moveTo     = (BoardPosition)((hash >> 32) & 63),
+            .moveFlags  = MoveFlags::None,
+            .staticEval = (EvalT)(hash >> 40)};
+}
+
+bool payloadsEqual(const SearchTTPayload& a, const SearchTTPayload& b) {
+    return a.score == b.score && a.depth == b.depth && a.tick == b.tick
+        && a.scoreType == b.scoreType && a.moveFrom == b.moveFrom && a.moveTo == b.moveTo
+        && a.moveFlags == b.moveFlags && a.staticEval == b.staticEval;
+}
+
+bool alwaysMoreValuable(const SearchTTEntry&, const SearchTTEntry&) {
+    return true;
+}
+
+}  // namespace
+
+TEST(TTableTests, TestStoreProbeErase) {
+    SearchTTable tTable(64);
+
+    const HashT hash = 0x1234'5678'9abc'def0ULL;
+    EXPECT_FALSE(tTable.probe(hash).has_value());
+
+    tTable.store({.hash = hash, .payload = payloadForHash(hash)}, alwaysMoreValuable);
+
+    const auto ttHit = tTable.probe(hash);
+    ENFORCE_TRUE(ttHit.has_value());
+    EXPECT_EQ(ttHit->hash, hash);
+    EXPECT_TRUE(payloadsEqual(ttHit->payload, payloadForHash(hash)));
+
+    EXPECT_TRUE(tTable.erase(hash));
+    EXPECT_FALSE(tTable.probe(hash).has_value());
+    EXPECT_FALSE(tTable.erase(hash));
+}
+
+TEST(TTableTests, TestFullBucket) {
+    // A single bucket, so that all entries collide.
+    SearchTTable tTable(1);
+
+    std::mt19937_64 hashRandom(42);
+    std::vector<HashT> hashes(SearchTTable::kEntriesPerBucket);
+    for (HashT& hash : hashes) {
+        hash = hashRandom();
+        tTable.store({.hash = hash, .payload = payloadForHash(hash)}, alwaysMoreValuable);
+    }
+
+    for (const HashT hash : hashes) {
+        const auto ttHit = tTable.probe(hash);
+        ENFORCE_TRUE(ttHit.has_value());
+        EXPECT_TRUE(payloadsEqual(ttHit->payload, payloadForHash(hash)));
+    }
+    EXPECT_EQ(tTable.getUtilization(), 1.f);
+}
+
+TEST(TTableTests, TestClearLazily) {
+    SearchTTable tTable(64);
+
+    const HashT hash      = 0x1234'5678'9abc'def0ULL;
+    const HashT otherHash = hash ^ 0xffff'0000'0000'0000ULL;
+    tTable.store({.hash = hash, .payload = payloadForHash(hash)}, alwaysMoreValuable);
+    tTable.store({.hash = otherHash, .payload = payloadForHash(otherHash)}, alwaysMoreValuable);
+
+    tTable.clearLazily();
+    EXPECT_FALSE(tTable.probe(hash).has_value());
+    EXPECT_EQ(tTable.getUtilization(), 0.f);
+
+    // Storing to the same bucket must drop the entries from before the clear.
+    tTable.store({.hash = hash, .payload = payloadForHash(hash)}, alwaysMoreValuable);
+    EXPECT_TRUE(tTable.probe(hash).has_value());
+    EXPECT_FALSE(tTable.probe(otherHash).has_value());
+
+    // Entries from before the clear stay cleared no matter how many clears follow.
+    for (int i = 0; i < 2 * SearchTTable::kNumTicks; ++i) {
+        tTable.clearLazily();
+    }
+    EXPECT_FALSE(tTable.probe(hash).has_value());
+}
+
+TEST(TTableTests, TestConcurrentAccessNeverReturnsTornEntries) {
+    static constexpr int kNumThreads        = 4;
+    static constexpr int kNumOpsPerThread   = 200'000;
+    static constexpr int kNumHashes         = 256;
+    static constexpr std::size_t kTableSize = 8;
+
+    // Use a tiny table so that the threads constantly overwrite each other's entries, and few
+    // distinct hashes so that probes regularly find a matching entry.
+    SearchTTable tTable(kTableSize);
+
+    std::mt19937_64 hashRandom(42);
+    std::vector<HashT> hashes(kNumHashes);
+    for (HashT& hash : hashes) {
+        hash = hashRandom();
+    }
+
+    std::vector<int> numCorrupted(kNumThreads, 0);
+    std::vector<std::thread> threads;
+
+    for (int threadIdx = 0; threadIdx < kNumThreads; ++threadIdx) {
+        threads.emplace_back([&, threadIdx]() {
+            std::mt19937_64 random(threadIdx);
+            for (int i = 0; i < kNumOpsPerThread; ++i) {
+                const HashT hash = hashes[random() % kNumHashes];
+
+                const auto ttHit = tTable.probe(hash);
+                if (ttHit && !payloadsEqual(ttHit->payload, payloadForHash(hash))) {
+                    ++numCorrupted[threadIdx];
+                }
+
+                tTable.store({.hash = hash, .payload = payloadForHash(hash)}, alwaysMoreValuable);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int threadIdx = 0; threadIdx < kNumThreads; ++threadIdx) {
+        EXPECT_EQ(numCorrupted[threadIdx], 0);
+    }
+}
+
+}  // namespace TTableTests
@@ -17,6 +17,8 @@
 #include <print>
 #include <ranges>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include <cstdlib>
 
@@ -38,35 +40,78 @@ std::string getParamsString(const std::array<double, kNumEvalParams>& paramsDoub
 
 std::array<double, kNumPieceTypes - 1> getAveragePieceValues(
         const EvalParams& params, const std::vector<ScoredPosition>& positions) {
+    // Positions are evaluated in chunks, to bound the memory used by the copies with a piece
+    // removed.
+    constexpr std::size_t kChunkSize = 1 << 14;
+
+    // A copy of a position with one piece removed.
+    struct RemovedPiece {
+        std::size_t referenceIdx;
+        int pieceIdx;
+        double sideFactor;
+    };
+
     std::array<double, kNumPieceTypes - 1> sumPieceValues{};
     std::array<double, kNumPieceTypes - 1> numPieceOccurrences{};
 
     const Evaluator evaluator(params);
+    const int numThreads = (int)std::thread::hardware_concurrency();
+
+    std::vector<GameState> gameStates;
+    std::vector<RemovedPiece> removedPieces;
+    std::vector<EvalT> evals;
 
-    for (const auto& [gameState, _] : positions) {
-        const EvalCalcT referenceEval = evaluator.evaluateRaw(gameState);
+    for (std::size_t chunkStart = 0; chunkStart < positions.size(); chunkStart += kChunkSize) {
+        const std::size_t chunkEnd = min(chunkStart + kChunkSize, positions.size());
+
+        gameStates.clear();
+        removedPieces.clear();
+
+        // The reference positions come first, followed by the copies in the order of removedPieces.
+        for (std::size_t positionIdx = chunkStart; positionIdx < chunkEnd; ++positionIdx) {
+            gameStates.push_back(positions[positionIdx].gameState);
+        }
 
-        for (int sideIdx = 0; sideIdx < kNumSides; ++sideIdx) {
-            const Side side         = (Side)sideIdx;
-            const double sideFactor = side == gameState.getSideToMove() ? 1.0 : -1.0;
+        for (std::size_t positionIdx = chunkStart; positionIdx < chunkEnd; ++positionIdx) {
+            const GameState& gameState = positions[positionIdx].gameState;
 
-            for (int pieceIdx = 0; pieceIdx < kNumPieceTypes - 1; ++pieceIdx) {
-                BitBoard pieceBitBoard = gameState.getPieceBitBoard(side, (Piece)pieceIdx);
+            for (int sideIdx = 0; sideIdx < kNumSides; ++sideIdx) {
+                const Side side         = (Side)sideIdx;
+                const double sideFactor = side == gameState.getSideToMove() ? 1.0 : -1.0;
 
-                while (pieceBitBoard != BitBoard::Empty) {
-                    const BoardPosition position = popFirstSetPosition(pieceBitBoard);
+                for (int pieceIdx = 0; pieceIdx < kNumPieceTypes - 1; ++pieceIdx) {
+                    BitBoard pieceBitBoard = gameState.getPieceBitBoard(side, (Piece)pieceIdx);
 
-                    GameState copyState = gameState;
-                    copyState.removePiece(position);
+                    while (pieceBitBoard != BitBoard::Empty) {
+                        const BoardPosition position = popFirstSetPosition(pieceBitBoard);
 
-                    const EvalCalcT eval    = evaluator.evaluateRaw(copyState);
-                    const double pieceValue = sideFactor * (referenceEval - eval);
+                        GameState copyState = gameState;
+                        copyState.removePiece(position);
 
-                    sumPieceValues[pieceIdx] += pieceValue;
-                    numPieceOccurrences[pieceIdx] += 1.0;
+                        gameStates.push_back(copyState);
+                        removedPieces.push_back(
+                                {.referenceIdx = positionIdx - chunkStart,
+                                 .pieceIdx     = pieceIdx,
+                                 .sideFactor   = sideFactor});
+                    }
                 }
             }
         }
+
+        evals.resize(gameStates.size());
+        evaluator.evaluateBatch(gameStates, evals, numThreads);
+
+        const std::size_t numReferences = chunkEnd - chunkStart;
+        for (std::size_t i = 0; i < removedPieces.size(); ++i) {
+            const RemovedPiece& removedPiece = removedPieces[i];
+
+            const EvalT referenceEval = evals[removedPiece.referenceIdx];
+            const EvalT eval          = evals[numReferences + i];
+            const double pieceValue   = removedPiece.sideFactor * (referenceEval - eval);
+
+            sumPieceValues[removedPiece.pieceIdx] += pieceValue;
+            numPieceOccurrences[removedPiece.pieceIdx] += 1.0;
+        }
     }
 
     for (int i = 0; i < kNumPieceTypes - 1; ++i) {
@@ -76,6 +76,10 @@ struct EvalCostFunctor : ceres::CostFunction {
                 const double sigmoidDerivative =
                         std::log(10.) * negPower / (s * (1 + negPower) * (1 + negPower));
 
+                // Both the sparsity structure and the gradient are sorted by param index.
+                const SparseGradient& gradient = evalWithGradient.gradient;
+                auto gradientIt                = gradient.begin();
+
                 for (std::size_t sparseIdx = 0; sparseIdx < sparsityStructure_.size();
                      ++sparseIdx) {
                     if (jacobians[sparseIdx] == nullptr) {
@@ -85,8 +89,17 @@ struct EvalCostFunctor : ceres::CostFunction {
                     const auto& [blockStart, blockSize] = sparsityStructure_[sparseIdx];
                     for (std::size_t blockIdx = 0; blockIdx < blockSize; ++blockIdx) {
                         const std::size_t denseIdx = blockStart + blockIdx;
-                        jacobians[sparseIdx][blockIdx] =
-                                -sigmoidDerivative * evalWithGradient.gradient[denseIdx];
+
+                        while (gradientIt != gradient.end() && gradientIt->paramIdx < denseIdx) {
+                            ++gradientIt;
+                        }
+
+                        const double derivative =
+                                gradientIt != gradient.end() && gradientIt->paramIdx == denseIdx
+                                        ? gradientIt->derivative
+                                        : 0.;
+
+                        jacobians[sparseIdx][blockIdx] = -sigmoidDerivative * derivative;
                     }
                 }
             }
@@ -208,15 +221,18 @@ void setAllEvalParameterBlocksVariable(
 SparsityStructure getSparsityStructure(const GameState& gameState, const Evaluator& evaluator) {
     const EvalWithGradient evalWithGradient = evaluator.evaluateWithGradient(gameState);
 
+    // The gradient only lists params with a non-zero derivative, sorted by param index. Tapered
+    // terms are blocks of two params.
     SparsityStructure sparsityStructure;
-    for (std::size_t i = 0; i < firstTaperedTermIdx; ++i) {
-        if (evalWithGradient.gradient[i] != 0) {
-            sparsityStructure.push_back({i, 1});
-        }
-    }
-    for (std::size_t i = firstTaperedTermIdx; i < kNumEvalParams; i += 2) {
-        if (evalWithGradient.gradient[i] != 0 || evalWithGradient.gradient[i + 1] != 0) {
-            sparsityStructure.push_back({i, 2});
+    for (const auto& [paramIdx, derivative] : evalWithGradient.gradient) {
+        const bool isTaperedTerm = paramIdx >= firstTaperedTermIdx;
+
+        const std::size_t blockStart =
+                isTaperedTerm ? paramIdx - (paramIdx - firstTaperedTermIdx) % 2 : paramIdx;
+        const std::size_t blockSize = isTaperedTerm ? 2 : 1;
+
+        if (sparsityStructure.empty() || sparsityStructure.back().first != blockStart) {
+            sparsityStructure.push_back({blockStart, blockSize});
         }
     }
 